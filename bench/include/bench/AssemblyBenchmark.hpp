@@ -0,0 +1,41 @@
+#ifndef ASSEMBLY_BENCHMARK_HPP
+#define ASSEMBLY_BENCHMARK_HPP
+
+#include <cstddef>    // std::size_t
+#include <functional> // std::function
+#include <string>     // std::string
+
+#include <nlohmann/json.hpp>
+
+#include <bench/ProductGenerator.hpp>
+
+#include <main/Assembly.hpp>
+
+using json = nlohmann::json;
+
+// Times the phases of the assembly generation on a synthetic product separately: computation of the blocking
+// rules, generation of the AND-OR graph and its import from JSON. Every phase is repeated and reported with its
+// wall time, the peak resident set size of a forked child running it once and the size of its output. The child starts
+// from the memory held by the benchmark at that point, hence its peak includes it.
+class AssemblyBenchmark
+{
+private:
+    ProductGenerator product;
+    std::size_t repetitions;
+    std::size_t num_threads;
+    std::string work_dir; // AND-OR graph JSON files for the import phase are written here
+
+    json time_phase(const std::function<void()> &phase) const;
+    json export_ao_graph(const Assembly &assembly) const;
+
+    static std::size_t get_peak_rss_kb();
+    static bool get_phase_peak_rss_kb(const std::function<void()> &phase, std::size_t &out);
+
+public:
+    explicit AssemblyBenchmark(const ProductSpec &spec, std::size_t repetitions = 3, std::size_t num_threads = 1, const std::string &work_dir = "");
+    ~AssemblyBenchmark() = default;
+
+    json run() const;
+};
+
+#endif // ASSEMBLY_BENCHMARK_HPP
@@ -0,0 +1,55 @@
+#ifndef PRODUCT_GENERATOR_HPP
+#define PRODUCT_GENERATOR_HPP
+
+#include <cstddef>       // std::size_t
+#include <random>        // std::mt19937
+#include <string>        // std::string
+#include <unordered_map> // std::unordered_map
+#include <vector>        // std::vector
+
+#include <graph/DiGraph.hpp>
+#include <graph/Graph.hpp>
+
+#include <main/Component.hpp>
+
+using Subassembly = std::vector<Component>;
+
+struct ProductSpec
+{
+    std::size_t num_components;
+    std::string topology;              // "grid" or "random"
+    std::size_t num_obstruction_graphs;
+    double constraint_density;         // probability that a component gets a technical constraint
+    unsigned int seed;
+};
+
+// Parametric synthetic products: components on a grid or random connection graph, random obstructions along the
+// connections in every direction and randomly placed technical constraints.
+class ProductGenerator
+{
+private:
+    ProductSpec spec;
+    std::mt19937 random_engine;
+
+    std::vector<Component> components;
+    Graph<Component> connection_graph;
+    std::vector<DiGraph<Component>> obstruction_graphs;
+    std::unordered_map<Component, std::vector<Subassembly>> technical_constraints;
+
+    void generate_components();
+    void generate_connection_graph();
+    void generate_obstruction_graphs();
+    void generate_technical_constraints();
+
+public:
+    explicit ProductGenerator(const ProductSpec &spec);
+    ~ProductGenerator() = default;
+
+    const ProductSpec &get_spec() const;
+    const std::vector<Component> &get_components() const;
+    const Graph<Component> &get_connection_graph() const;
+    const std::vector<DiGraph<Component>> &get_obstruction_graphs() const;
+    const std::unordered_map<Component, std::vector<Subassembly>> &get_technical_constraints() const;
+};
+
+#endif // PRODUCT_GENERATOR_HPP
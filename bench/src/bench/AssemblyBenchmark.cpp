@@ -0,0 +1,216 @@
+#include <algorithm>     // std::max, std::min
+#include <chrono>        // std::chrono::duration, std::chrono::steady_clock
+#include <cstddef>       // std::size_t
+#include <filesystem>    // std::filesystem::create_directories, std::filesystem::remove, std::filesystem::temp_directory_path
+#include <fstream>       // std::ofstream
+#include <functional>    // std::function
+#include <iostream>      // std::cerr, std::endl
+#include <string>        // std::string, std::to_string
+#include <system_error>  // std::error_code
+#include <tuple>         // std::get
+#include <unordered_map> // std::unordered_map
+#include <vector>        // std::vector
+
+#include <sys/resource.h> // getrusage, rusage, RUSAGE_SELF
+#include <sys/wait.h>     // wait4, WEXITSTATUS, WIFEXITED
+#include <unistd.h>       // _exit, fork, pid_t
+
+#include <nlohmann/json.hpp>
+
+#include <bench/AssemblyBenchmark.hpp>
+#include <bench/ProductGenerator.hpp>
+
+#include <main/Assembly.hpp>
+
+using json = nlohmann::json;
+
+AssemblyBenchmark::AssemblyBenchmark(const ProductSpec &spec, std::size_t repetitions, std::size_t num_threads, const std::string &work_dir)
+    : product{spec}, repetitions{std::max<std::size_t>(repetitions, 1)}, num_threads{std::max<std::size_t>(num_threads, 1)},
+      work_dir{work_dir.empty() ? (std::filesystem::temp_directory_path() / "hrc_pomdp_bench").string() : work_dir}
+{
+}
+
+std::size_t AssemblyBenchmark::get_peak_rss_kb()
+{
+    // ru_maxrss is reported in kilobytes on Linux
+    rusage usage{};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<std::size_t>(usage.ru_maxrss);
+}
+
+bool AssemblyBenchmark::get_phase_peak_rss_kb(const std::function<void()> &phase, std::size_t &out)
+{
+    // ru_maxrss of the process never decreases, hence every phase runs in its own child and the child's peak is read
+    pid_t pid{fork()};
+    if (pid < 0)
+        return false;
+
+    if (pid == 0)
+    {
+        try
+        {
+            phase();
+        }
+        catch (...)
+        {
+            _exit(1);
+        }
+        _exit(0);
+    }
+
+    int status{0};
+    rusage usage{};
+    if (wait4(pid, &status, 0, &usage) != pid || !WIFEXITED(status) || WEXITSTATUS(status) != 0)
+        return false;
+
+    out = static_cast<std::size_t>(usage.ru_maxrss);
+    return true;
+}
+
+json AssemblyBenchmark::time_phase(const std::function<void()> &phase) const
+{
+    // measured first, so the child does not inherit what the timed runs leave on the heap
+    std::size_t peak_rss_kb{0};
+    bool has_peak_rss{AssemblyBenchmark::get_phase_peak_rss_kb(phase, peak_rss_kb)};
+    if (!has_peak_rss)
+        std::cerr << "[Assembly benchmark]: Unable to measure the peak resident set size of a phase" << std::endl;
+
+    std::vector<double> wall_times{};
+    for (std::size_t i{0}; i < this->repetitions; ++i)
+    {
+        auto start = std::chrono::steady_clock::now();
+        phase();
+        auto end = std::chrono::steady_clock::now();
+        wall_times.push_back(std::chrono::duration<double>(end - start).count());
+    }
+
+    double min_time{wall_times.front()};
+    double max_time{wall_times.front()};
+    double total_time{0.0};
+    for (double wall_time : wall_times)
+    {
+        min_time = std::min(min_time, wall_time);
+        max_time = std::max(max_time, wall_time);
+        total_time += wall_time;
+    }
+
+    json result{};
+    result["wall_time_s"] = {{"min", min_time},
+                             {"mean", total_time / static_cast<double>(wall_times.size())},
+                             {"max", max_time},
+                             {"runs", wall_times}};
+    if (has_peak_rss)
+        result["peak_rss_kb"] = peak_rss_kb;
+    return result;
+}
+
+json AssemblyBenchmark::export_ao_graph(const Assembly &assembly) const
+{
+    // same layout as the files read by Assembly::import_ao_graph, with the components numbered by first appearance
+    std::unordered_map<Subassembly, std::string> component_keys{};
+    json ao_json{};
+    ao_json["components"] = json::object();
+    ao_json["unions"] = json::object();
+
+    auto get_key = [&component_keys, &ao_json](const Subassembly &subassembly) {
+        auto it = component_keys.find(subassembly);
+        if (it != component_keys.end())
+            return it->second;
+
+        std::string key{std::to_string(component_keys.size())};
+        std::string label{};
+        for (const auto &component : subassembly)
+            label += component.get_name();
+        component_keys.emplace(subassembly, key);
+        ao_json["components"][key] = {{"label", label}, {"parent_unions", json::array()}};
+        return key;
+    };
+
+    std::size_t num_unions{0};
+    for (const auto &edge : assembly.get_ao_graph().get_edges())
+    {
+        int union_id{static_cast<int>(num_unions++)};
+        std::string union_key{std::to_string(union_id)};
+        std::string parent_key{get_key(std::get<0>(edge))};
+        std::vector<std::string> child_keys{};
+        for (const auto &child : std::get<1>(edge))
+        {
+            child_keys.push_back(get_key(child));
+            ao_json["components"][child_keys.back()]["parent_unions"].push_back(union_key);
+        }
+        ao_json["unions"][union_key] = {{"parent_component", parent_key}, {"child_components", child_keys}, {"id", union_id}};
+    }
+
+    return ao_json;
+}
+
+json AssemblyBenchmark::run() const
+{
+    ProductSpec spec{this->product.get_spec()};
+    json report{};
+    report["product"] = {{"num_components", spec.num_components},
+                         {"topology", spec.topology},
+                         {"num_obstruction_graphs", spec.num_obstruction_graphs},
+                         {"constraint_density", spec.constraint_density},
+                         {"seed", spec.seed},
+                         {"num_connections", this->product.get_connection_graph().get_edges().size()},
+                         {"num_technical_constraints", this->product.get_technical_constraints().size()}};
+    report["repetitions"] = this->repetitions;
+    report["num_threads"] = this->num_threads;
+    report["peak_rss_kb_before"] = AssemblyBenchmark::get_peak_rss_kb();
+
+    // the constructor runs the whole pipeline once, which also serves as warm-up for the separate phases
+    Assembly assembly{};
+    report["construction"] = this->time_phase([this, &assembly]() {
+        assembly = Assembly{this->product.get_obstruction_graphs(), this->product.get_connection_graph(),
+                            this->product.get_technical_constraints(), this->num_threads};
+    });
+
+    std::unordered_map<Component, std::vector<Subassembly>> blocking_rules{};
+    report["compute_blocking_rules"] = this->time_phase([&assembly, &blocking_rules]() {
+        blocking_rules = assembly.compute_blocking_rules();
+    });
+    std::size_t num_blocking_rules{0};
+    for (const auto &rules : blocking_rules)
+        num_blocking_rules += rules.second.size();
+    report["compute_blocking_rules"]["num_rules"] = num_blocking_rules;
+
+    AndOrGraph<Subassembly> ao_graph{};
+    report["generate_ao_graph"] = this->time_phase([&assembly, &ao_graph]() {
+        ao_graph = assembly.generate_ao_graph();
+    });
+    report["generate_ao_graph"]["num_nodes"] = ao_graph.get_nodes().size();
+    report["generate_ao_graph"]["num_edges"] = ao_graph.get_edges().size();
+
+    std::error_code error{};
+    std::filesystem::create_directories(this->work_dir, error);
+    std::string file_path{this->work_dir + "/ao_graph_" + std::to_string(spec.num_components) + "_" + std::to_string(spec.seed) + ".json"};
+    json ao_json = this->export_ao_graph(assembly);
+    std::ofstream file{file_path};
+    if (!file.is_open())
+    {
+        std::cerr << "[Assembly benchmark]: Unable to write " << file_path << ", skipping the import from file" << std::endl;
+    }
+    else
+    {
+        file << ao_json;
+        file.close();
+
+        Assembly imported_assembly{};
+        report["import_ao_graph_file"] = this->time_phase([&imported_assembly, &file_path]() {
+            imported_assembly.import_ao_graph(file_path);
+        });
+        report["import_ao_graph_file"]["num_edges"] = imported_assembly.get_ao_graph().get_edges().size();
+        report["import_ao_graph_file"]["file_bytes"] = std::filesystem::file_size(file_path, error);
+        std::filesystem::remove(file_path, error);
+    }
+
+    Assembly imported_assembly{};
+    report["import_ao_graph_json"] = this->time_phase([&imported_assembly, &ao_json]() {
+        imported_assembly.import_ao_graph(ao_json);
+    });
+    report["import_ao_graph_json"]["num_edges"] = imported_assembly.get_ao_graph().get_edges().size();
+
+    report["peak_rss_kb"] = AssemblyBenchmark::get_peak_rss_kb();
+    return report;
+}
@@ -0,0 +1,141 @@
+#include <cmath>         // std::ceil, std::sqrt
+#include <cstddef>       // std::size_t
+#include <iomanip>       // std::setfill, std::setw
+#include <random>        // std::bernoulli_distribution, std::uniform_int_distribution
+#include <sstream>       // std::ostringstream
+#include <string>        // std::string
+#include <unordered_map> // std::unordered_map
+#include <vector>        // std::vector
+
+#include <bench/ProductGenerator.hpp>
+
+#include <graph/DiGraph.hpp>
+#include <graph/Graph.hpp>
+
+#include <main/Component.hpp>
+
+using Subassembly = std::vector<Component>;
+
+ProductGenerator::ProductGenerator(const ProductSpec &spec)
+    : spec{spec}, random_engine{spec.seed},
+      components{}, connection_graph{}, obstruction_graphs{}, technical_constraints{}
+{
+    this->generate_components();
+    this->generate_connection_graph();
+    this->generate_obstruction_graphs();
+    this->generate_technical_constraints();
+}
+
+void ProductGenerator::generate_components()
+{
+    std::size_t num_digits{std::to_string(this->spec.num_components).size()};
+    for (std::size_t i{0}; i < this->spec.num_components; ++i)
+    {
+        std::ostringstream ss_name{};
+        ss_name << "part_" << std::setw(num_digits) << std::setfill('0') << i;
+        this->components.push_back(Component{ss_name.str()});
+    }
+}
+
+void ProductGenerator::generate_connection_graph()
+{
+    std::size_t num_components{this->components.size()};
+    if (this->spec.topology == "grid")
+    {
+        std::size_t width{static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(num_components))))};
+        for (std::size_t i{0}; i < num_components; ++i)
+        {
+            if ((i + 1) % width != 0 && i + 1 < num_components)
+                this->connection_graph.add_edge(this->components.at(i), this->components.at(i + 1));
+            if (i + width < num_components)
+                this->connection_graph.add_edge(this->components.at(i), this->components.at(i + width));
+        }
+    }
+    else
+    {
+        // random spanning tree, so that the product is connected, with half as many extra connections on top
+        for (std::size_t i{1}; i < num_components; ++i)
+        {
+            std::uniform_int_distribution<std::size_t> distribution{0, i - 1};
+            this->connection_graph.add_edge(this->components.at(i), this->components.at(distribution(this->random_engine)));
+        }
+
+        std::uniform_int_distribution<std::size_t> distribution{0, num_components - 1};
+        for (std::size_t k{0}; k < num_components / 2; ++k)
+        {
+            std::size_t u{distribution(this->random_engine)};
+            std::size_t v{distribution(this->random_engine)};
+            if (u != v)
+                this->connection_graph.add_edge(this->components.at(u), this->components.at(v));
+        }
+    }
+
+    if (num_components == 1)
+        this->connection_graph.add_edge(this->components.front(), this->components.front());
+}
+
+void ProductGenerator::generate_obstruction_graphs()
+{
+    // every connected pair obstructs each other in a direction with equal probability: none, one way, other way
+    std::uniform_int_distribution<int> distribution{0, 2};
+    for (std::size_t d{0}; d < this->spec.num_obstruction_graphs; ++d)
+    {
+        DiGraph<Component> obstruction_graph{"obstruction_graph_" + std::to_string(d)};
+        for (const auto &connection : this->connection_graph.get_edges())
+        {
+            if (connection.first == connection.second)
+                continue;
+
+            int orientation{distribution(this->random_engine)};
+            if (orientation == 1)
+                obstruction_graph.add_edge(connection.first, connection.second);
+            else if (orientation == 2)
+                obstruction_graph.add_edge(connection.second, connection.first);
+        }
+        this->obstruction_graphs.push_back(obstruction_graph);
+    }
+}
+
+void ProductGenerator::generate_technical_constraints()
+{
+    // a constrained component can't be left out of a subassembly containing two of its neighbors
+    std::bernoulli_distribution has_constraint{this->spec.constraint_density};
+    for (const auto &component : this->components)
+    {
+        std::vector<Component> neighbors{this->connection_graph.get_neighbors(component)};
+        if (neighbors.size() < 2 || !has_constraint(this->random_engine))
+            continue;
+
+        std::uniform_int_distribution<std::size_t> distribution{0, neighbors.size() - 1};
+        std::size_t first{distribution(this->random_engine)};
+        std::size_t second{distribution(this->random_engine)};
+        if (first == second)
+            second = (second + 1) % neighbors.size();
+        this->technical_constraints[component].push_back(Subassembly{neighbors.at(first), neighbors.at(second)});
+    }
+}
+
+const ProductSpec &ProductGenerator::get_spec() const
+{
+    return this->spec;
+}
+
+const std::vector<Component> &ProductGenerator::get_components() const
+{
+    return this->components;
+}
+
+const Graph<Component> &ProductGenerator::get_connection_graph() const
+{
+    return this->connection_graph;
+}
+
+const std::vector<DiGraph<Component>> &ProductGenerator::get_obstruction_graphs() const
+{
+    return this->obstruction_graphs;
+}
+
+const std::unordered_map<Component, std::vector<Subassembly>> &ProductGenerator::get_technical_constraints() const
+{
+    return this->technical_constraints;
+}
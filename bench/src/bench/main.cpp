@@ -0,0 +1,99 @@
+#include <cstddef>   // std::size_t
+#include <fstream>   // std::ofstream
+#include <iostream>  // std::cerr, std::cout, std::endl
+#include <stdexcept> // std::invalid_argument, std::out_of_range
+#include <string>    // std::stod, std::stoul, std::string
+
+#include <nlohmann/json.hpp>
+
+#include <bench/AssemblyBenchmark.hpp>
+#include <bench/ProductGenerator.hpp>
+
+using json = nlohmann::json;
+
+static void print_usage()
+{
+    std::cerr << "Usage: hrc_pomdp_bench [components=<n>] [topology=grid|random] [obstructions=<k>] [density=<p>] [seed=<s>]" << std::endl
+              << "                       [repetitions=<r>] [threads=<t>] [output=<file>]" << std::endl
+              << "Without an output file the JSON report is written to stdout." << std::endl;
+}
+
+int main(int argc, char **argv)
+{
+    ProductSpec spec{8, "random", 3, 0.2, 1};
+    std::size_t repetitions{3};
+    std::size_t num_threads{1};
+    std::string output_path{};
+
+    for (int i{1}; i < argc; ++i)
+    {
+        std::string argument{argv[i]};
+        std::size_t separator{argument.find('=')};
+        if (separator == std::string::npos)
+        {
+            std::cerr << "[Assembly benchmark]: Ignoring argument " << argument << ", expected key=value" << std::endl;
+            continue;
+        }
+
+        std::string key{argument.substr(0, separator)};
+        std::string value{argument.substr(separator + 1)};
+        try
+        {
+            if (key == "components")
+                spec.num_components = std::stoul(value);
+            else if (key == "topology")
+                spec.topology = value;
+            else if (key == "obstructions")
+                spec.num_obstruction_graphs = std::stoul(value);
+            else if (key == "density")
+                spec.constraint_density = std::stod(value);
+            else if (key == "seed")
+                spec.seed = static_cast<unsigned int>(std::stoul(value));
+            else if (key == "repetitions")
+                repetitions = std::stoul(value);
+            else if (key == "threads")
+                num_threads = std::stoul(value);
+            else if (key == "output")
+                output_path = value;
+            else
+                std::cerr << "[Assembly benchmark]: Unknown argument " << key << std::endl;
+        }
+        catch (const std::invalid_argument &)
+        {
+            std::cerr << "[Assembly benchmark]: Invalid value " << value << " for " << key << std::endl;
+            print_usage();
+            return 1;
+        }
+        catch (const std::out_of_range &)
+        {
+            std::cerr << "[Assembly benchmark]: Value " << value << " for " << key << " is out of range" << std::endl;
+            print_usage();
+            return 1;
+        }
+    }
+
+    if (spec.num_components == 0 || (spec.topology != "grid" && spec.topology != "random"))
+    {
+        std::cerr << "[Assembly benchmark]: The product needs at least one component and a grid or random topology" << std::endl;
+        print_usage();
+        return 1;
+    }
+
+    AssemblyBenchmark benchmark{spec, repetitions, num_threads};
+    json report = benchmark.run();
+
+    if (output_path.empty())
+    {
+        std::cout << report.dump(4) << std::endl;
+        return 0;
+    }
+
+    std::ofstream file{output_path};
+    if (!file.is_open())
+    {
+        std::cerr << "[Assembly benchmark]: Unable to write " << output_path << std::endl;
+        return 1;
+    }
+    file << report.dump(4) << std::endl;
+    return 0;
+}
@@ -1,10 +1,16 @@
 #ifndef AND_OR_GRAPH_HPP
 #define AND_OR_GRAPH_HPP
 
+#include <cstddef>       // std::size_t
 #include <tuple>         // std::tuple
-#include <unordered_map> // std::unordered_map
+#include <unordered_map> // std::unordered_map, std::unordered_multimap
 #include <vector>        // std::vector
 
+#include <boost/functional/hash.hpp>
+
+#include <graph/FrozenAndOrGraph.hpp>
+#include <graph/IdRange.hpp>
+
 template <typename T>
 class AndOrGraph
 {
@@ -22,28 +28,61 @@ private:
 
     struct AndEdge
     {
-        std::vector<Node> child_nodes;
+        std::vector<int> child_ids; // unique, sorted by the data of the children
         int id;
 
-        explicit AndEdge(const std::vector<Node> &child_nodes, int id);
+        explicit AndEdge(const std::vector<int> &child_ids, int id);
         ~AndEdge() = default;
 
         bool operator==(const AndEdge &rhs) const;
-        bool operator<(const AndEdge &rhs) const;
     };
 
     std::unordered_map<int, std::vector<AndEdge>> adjacency_list;
+    std::unordered_map<int, std::vector<int>> parent_ids; // ids of the nodes having an edge to the node
     std::unordered_map<int, Node> node_ids;
-
-    bool get_id(const Node &node, int &out) const;
+    std::unordered_multimap<std::size_t, int> node_index; // hash of the node data -> ids sharing that hash
 
     void add_node(const Node &node, int &out_id);
+    void sort_children(std::vector<int> &child_ids) const;
 
 public:
+    // Batch construction: nodes are interned as they are added and moved into the graph, duplicate edges are dropped
+    // in a single hash pass on build(). The result is identical to adding the same edges one by one.
+    class Builder
+    {
+    private:
+        std::vector<T> nodes;
+        std::unordered_multimap<std::size_t, int> node_index;
+        std::vector<std::tuple<int, std::vector<int>, int>> edges; // parent id, child ids, edge id
+
+        int intern(T &&data);
+
+    public:
+        Builder();
+        ~Builder() = default;
+
+        void reserve(std::size_t num_nodes, std::size_t num_edges);
+        void add_node(T data); // interns the node ahead of its edges, e.g. to keep the node ids of a snapshot
+        void add_edge(T parent_data, std::vector<T> child_data, int id = -1);
+
+        AndOrGraph<T> build();
+    };
+
     AndOrGraph();
     explicit AndOrGraph(const std::vector<std::tuple<T, std::vector<T>, int>> &edges);
     ~AndOrGraph() = default;
 
+    // id based access, node ids are dense and given in insertion order
+    std::size_t get_num_nodes() const;
+    bool get_id(const T &data, int &out) const;
+    const T &get_node(int node_id) const;
+
+    std::size_t get_num_edges(int node_id) const;               // AND-edges of the node
+    IdRange get_child_ids(int node_id, std::size_t edge) const; // children of the edge-th AND-edge of the node
+    int get_edge_id(int node_id, std::size_t edge) const;
+    IdRange get_parent_ids(int node_id) const;
+
+    // value based access
     std::vector<T> get_nodes() const;
     std::vector<std::tuple<T, std::vector<T>, int>> get_edges() const;
 
@@ -55,6 +94,8 @@ public:
 
     void add_edge(const T &parent_data, const std::vector<T> &child_data, int id = -1);
     void add_edges(const std::vector<std::tuple<T, std::vector<T>, int>> &edges);
+
+    FrozenAndOrGraph<T> freeze() const;
 };
 
 #include <graph/AndOrGraph.tpp>
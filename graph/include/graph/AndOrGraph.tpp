@@ -1,13 +1,19 @@
-#include <algorithm>     // std::copy_if, std::find, std::find_if, std::for_each, std::sort, std::transform
+#include <algorithm>     // std::find, std::for_each, std::sort, std::transform, std::unique
+#include <cstddef>       // std::size_t
+#include <functional>    // std::hash
 #include <iterator>      // std::back_inserter
 #include <tuple>         // std::get, std::make_tuple, std::tuple
-#include <unordered_map> // std::unordered_map
-#include <utility>       // std::make_pair
+#include <unordered_map> // std::unordered_map, std::unordered_multimap
+#include <unordered_set> // std::unordered_set
+#include <utility>       // std::make_pair, std::move, std::pair
 #include <vector>        // std::vector
 
+#include <graph/FrozenAndOrGraph.hpp>
+#include <graph/IdRange.hpp>
+
 template <typename T>
 AndOrGraph<T>::AndOrGraph()
-    : adjacency_list{}, node_ids{}
+    : adjacency_list{}, parent_ids{}, node_ids{}, node_index{}
 {
 }
 
@@ -40,60 +46,96 @@ bool AndOrGraph<T>::Node::operator<(const Node &rhs) const
 
 // EDGE - BEGIN
 template <typename T>
-AndOrGraph<T>::AndEdge::AndEdge(const std::vector<Node> &child_nodes, int id)
-    : child_nodes{}, id{id}
+AndOrGraph<T>::AndEdge::AndEdge(const std::vector<int> &child_ids, int id)
+    : child_ids{child_ids}, id{id}
 {
-    std::copy_if(child_nodes.begin(), child_nodes.end(), std::back_inserter(this->child_nodes),
-                 [this](const Node child_node) {
-                     return (std::find(this->child_nodes.begin(), this->child_nodes.end(), child_node) == this->child_nodes.end());
-                 });
-
-    std::sort(this->child_nodes.begin(), this->child_nodes.end());
 }
 
 template <typename T>
 bool AndOrGraph<T>::AndEdge::operator==(const AndEdge &rhs) const
 {
-    return (this->child_nodes == rhs.child_nodes);
-}
-
-template <typename T>
-bool AndOrGraph<T>::AndEdge::operator<(const AndEdge &rhs) const
-{
-    return (this->child_nodes < rhs.child_nodes);
+    return (this->child_ids == rhs.child_ids);
 }
 // EDGE - END
 
 template <typename T>
-bool AndOrGraph<T>::get_id(const Node &node, int &out) const
+bool AndOrGraph<T>::get_id(const T &data, int &out) const
 {
-    auto it = std::find_if(this->node_ids.begin(), this->node_ids.end(),
-                           [&node](const auto &m) {
-                               return (m.second == node);
-                           });
-
-    if (it != node_ids.end())
+    auto range = this->node_index.equal_range(std::hash<T>{}(data));
+    for (auto it = range.first; it != range.second; ++it)
     {
-        out = it->first;
-        return true;
-    }
-    else
-    {
-        out = this->node_ids.size();
-        return false;
+        if (this->node_ids.at(it->second).data == data)
+        {
+            out = it->second;
+            return true;
+        }
     }
+
+    out = this->node_ids.size();
+    return false;
 }
 
 template <typename T>
 void AndOrGraph<T>::add_node(const Node &node, int &out_id)
 {
-    if (!this->get_id(node, out_id))
+    if (!this->get_id(node.data, out_id))
     {
         this->node_ids.emplace(std::make_pair(out_id, node));
+        this->node_index.emplace(std::make_pair(std::hash<T>{}(node.data), out_id));
         this->adjacency_list.emplace(std::make_pair(out_id, std::vector<AndEdge>{}));
+        this->parent_ids.emplace(std::make_pair(out_id, std::vector<int>{}));
     }
 }
 
+template <typename T>
+void AndOrGraph<T>::sort_children(std::vector<int> &child_ids) const
+{
+    // children with equal data have equal ids, hence equal sets of children give equal id lists
+    std::sort(child_ids.begin(), child_ids.end(),
+              [this](int lhs_id, int rhs_id) {
+                  return (this->node_ids.at(lhs_id) < this->node_ids.at(rhs_id));
+              });
+    child_ids.erase(std::unique(child_ids.begin(), child_ids.end()), child_ids.end());
+}
+
+template <typename T>
+std::size_t AndOrGraph<T>::get_num_nodes() const
+{
+    return this->node_ids.size();
+}
+
+template <typename T>
+const T &AndOrGraph<T>::get_node(int node_id) const
+{
+    return this->node_ids.at(node_id).data;
+}
+
+template <typename T>
+std::size_t AndOrGraph<T>::get_num_edges(int node_id) const
+{
+    return this->adjacency_list.at(node_id).size();
+}
+
+template <typename T>
+IdRange AndOrGraph<T>::get_child_ids(int node_id, std::size_t edge) const
+{
+    const std::vector<int> &child_ids{this->adjacency_list.at(node_id).at(edge).child_ids};
+    return IdRange{child_ids.data(), child_ids.data() + child_ids.size()};
+}
+
+template <typename T>
+int AndOrGraph<T>::get_edge_id(int node_id, std::size_t edge) const
+{
+    return this->adjacency_list.at(node_id).at(edge).id;
+}
+
+template <typename T>
+IdRange AndOrGraph<T>::get_parent_ids(int node_id) const
+{
+    const std::vector<int> &parent_ids{this->parent_ids.at(node_id)};
+    return IdRange{parent_ids.data(), parent_ids.data() + parent_ids.size()};
+}
+
 template <typename T>
 std::vector<T> AndOrGraph<T>::get_nodes() const
 {
@@ -110,21 +152,14 @@ std::vector<std::tuple<T, std::vector<T>, int>> AndOrGraph<T>::get_edges() const
 {
     std::vector<std::tuple<T, std::vector<T>, int>> edges_data{};
 
-    for (const auto m : this->node_ids)
+    for (const auto &m : this->node_ids)
     {
-        int parent_node_id{};
-        if (this->get_id(m.second, parent_node_id))
+        for (const AndEdge &edge : this->adjacency_list.at(m.first))
         {
-            T parent_node{m.second.data};
-            for (const AndEdge &edge : this->adjacency_list.at(parent_node_id))
-            {               
-                std::vector<T> child_data{};
-                std::transform(edge.child_nodes.begin(), edge.child_nodes.end(), std::back_inserter(child_data),
-                            [](const Node child_node) {
-                                return child_node.data;
-                            });
-                edges_data.push_back(std::make_tuple(parent_node, child_data, edge.id));
-            }
+            std::vector<T> child_data{};
+            for (int child_id : edge.child_ids)
+                child_data.push_back(this->node_ids.at(child_id).data);
+            edges_data.push_back(std::make_tuple(m.second.data, child_data, edge.id));
         }
     }
 
@@ -137,15 +172,13 @@ std::vector<std::vector<T>> AndOrGraph<T>::get_successors(const T &data) const
     std::vector<std::vector<T>> successors{};
 
     int data_id{};
-    if (this->get_id(Node{data}, data_id))
+    if (this->get_id(data, data_id))
     {
         for (const AndEdge &edge : this->adjacency_list.at(data_id))
         {
             std::vector<T> child_data{};
-            std::transform(edge.child_nodes.begin(), edge.child_nodes.end(), std::back_inserter(child_data),
-                           [](const Node child_node) {
-                               return child_node.data;
-                           });
+            for (int child_id : edge.child_ids)
+                child_data.push_back(this->node_ids.at(child_id).data);
             successors.push_back(child_data);
         }
     }
@@ -159,18 +192,10 @@ std::vector<T> AndOrGraph<T>::get_predecessors(const T &data) const
     std::vector<T> predecessors{};
 
     int data_id{};
-    if (this->get_id(Node{data}, data_id))
+    if (this->get_id(data, data_id))
     {
-        for (const auto m : this->node_ids)
-        {
-            std::vector<T> successors{};
-            for (const std::vector<T> &edge_successors : this->get_successors(m.second.data))
-                successors.insert(successors.end(), edge_successors.begin(), edge_successors.end());
-
-            if (std::find(successors.begin(), successors.end(), data) != successors.end() &&
-                std::find(predecessors.begin(), predecessors.end(), data) == predecessors.end())
-                predecessors.push_back(m.second.data);
-        }
+        for (int parent_id : this->parent_ids.at(data_id))
+            predecessors.push_back(this->node_ids.at(parent_id).data);
     }
 
     return predecessors;
@@ -179,46 +204,55 @@ std::vector<T> AndOrGraph<T>::get_predecessors(const T &data) const
 template <typename T>
 std::vector<T> AndOrGraph<T>::get_root_nodes() const
 {
-    std::vector<T> nodes_data{this->get_nodes()};
-
     std::vector<T> root_nodes{};
-    std::copy_if(nodes_data.begin(), nodes_data.end(), std::back_inserter(root_nodes),
-                 [this](const T &data) { return this->get_predecessors(data).empty(); });
+    for (const auto &m : this->node_ids)
+    {
+        if (this->parent_ids.at(m.first).empty())
+            root_nodes.push_back(m.second.data);
+    }
     return root_nodes;
 }
 
 template <typename T>
 std::vector<T> AndOrGraph<T>::get_leaf_nodes() const
 {
-    std::vector<T> nodes_data{this->get_nodes()};
-
     std::vector<T> leaf_nodes{};
-    std::copy_if(nodes_data.begin(), nodes_data.end(), std::back_inserter(leaf_nodes),
-                 [this](const T &data) { return this->get_successors(data).empty(); });
+    for (const auto &m : this->node_ids)
+    {
+        if (this->adjacency_list.at(m.first).empty())
+            leaf_nodes.push_back(m.second.data);
+    }
     return leaf_nodes;
 }
 
 template <typename T>
 void AndOrGraph<T>::add_edge(const T &parent_data, const std::vector<T> &child_data, int id)
 {
-    Node parent_node{parent_data};
     int parent_id{};
-    this->add_node(parent_node, parent_id);
+    this->add_node(Node{parent_data}, parent_id);
 
-    std::vector<Node> child_nodes{};
+    std::vector<int> child_ids{};
     for (const T &data : child_data)
     {
-        Node child_node{data};
         int child_id{};
-        this->add_node(child_node, child_id);
-
-        child_nodes.push_back(child_node);
+        this->add_node(Node{data}, child_id);
+        child_ids.push_back(child_id);
     }
+    this->sort_children(child_ids);
 
-    AndEdge edge{child_nodes, id};
+    AndEdge edge{child_ids, id};
     auto it = this->adjacency_list.find(parent_id);
     if (std::find(it->second.begin(), it->second.end(), edge) == it->second.end())
+    {
         it->second.push_back(edge);
+
+        for (int child_id : child_ids)
+        {
+            std::vector<int> &parents{this->parent_ids.at(child_id)};
+            if (std::find(parents.begin(), parents.end(), parent_id) == parents.end())
+                parents.push_back(parent_id);
+        }
+    }
 }
 
 template <typename T>
@@ -228,4 +262,117 @@ void AndOrGraph<T>::add_edges(const std::vector<std::tuple<T, std::vector<T>, in
                   [this](const std::tuple<T, std::vector<T>, int> &edge) {
                       this->add_edge(std::get<0>(edge), std::get<1>(edge), std::get<2>(edge));
                   });
-}
\ No newline at end of file
+}
+
+template <typename T>
+FrozenAndOrGraph<T> AndOrGraph<T>::freeze() const
+{
+    std::vector<T> frozen_nodes{};
+    frozen_nodes.reserve(this->node_ids.size());
+    for (size_t id{0}; id < this->node_ids.size(); ++id)
+        frozen_nodes.push_back(this->node_ids.at(id).data);
+
+    std::vector<std::tuple<int, std::vector<int>, int>> frozen_edges{};
+    for (size_t parent_id{0}; parent_id < this->node_ids.size(); ++parent_id)
+    {
+        for (const AndEdge &edge : this->adjacency_list.at(parent_id))
+            frozen_edges.push_back(std::make_tuple(static_cast<int>(parent_id), edge.child_ids, edge.id));
+    }
+
+    return FrozenAndOrGraph<T>{frozen_nodes, frozen_edges};
+}
+
+// BUILDER - BEGIN
+template <typename T>
+AndOrGraph<T>::Builder::Builder()
+    : nodes{}, node_index{}, edges{}
+{
+}
+
+template <typename T>
+int AndOrGraph<T>::Builder::intern(T &&data)
+{
+    std::size_t hash{std::hash<T>{}(data)};
+    auto range = this->node_index.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (this->nodes.at(it->second) == data)
+            return it->second;
+    }
+
+    int node_id{static_cast<int>(this->nodes.size())};
+    this->nodes.push_back(std::move(data));
+    this->node_index.emplace(std::make_pair(hash, node_id));
+    return node_id;
+}
+
+template <typename T>
+void AndOrGraph<T>::Builder::reserve(std::size_t num_nodes, std::size_t num_edges)
+{
+    this->nodes.reserve(num_nodes);
+    this->node_index.reserve(num_nodes);
+    this->edges.reserve(num_edges);
+}
+
+template <typename T>
+void AndOrGraph<T>::Builder::add_node(T data)
+{
+    this->intern(std::move(data));
+}
+
+template <typename T>
+void AndOrGraph<T>::Builder::add_edge(T parent_data, std::vector<T> child_data, int id)
+{
+    int parent_id{this->intern(std::move(parent_data))};
+
+    std::vector<int> child_ids{};
+    child_ids.reserve(child_data.size());
+    for (T &data : child_data)
+        child_ids.push_back(this->intern(std::move(data)));
+
+    this->edges.push_back(std::make_tuple(parent_id, std::move(child_ids), id));
+}
+
+template <typename T>
+AndOrGraph<T> AndOrGraph<T>::Builder::build()
+{
+    // the id maps are filled in id order without reserving, so that they iterate like a graph built edge by edge
+    AndOrGraph<T> graph{};
+    for (size_t id{0}; id < this->nodes.size(); ++id)
+    {
+        graph.node_ids.emplace(std::make_pair(static_cast<int>(id), Node{std::move(this->nodes.at(id))}));
+        graph.adjacency_list.emplace(std::make_pair(static_cast<int>(id), std::vector<AndEdge>{}));
+        graph.parent_ids.emplace(std::make_pair(static_cast<int>(id), std::vector<int>{}));
+    }
+    graph.node_index = std::move(this->node_index);
+
+    // AND-edges are equal if they have the same parent and the same set of children
+    std::unordered_set<std::pair<int, std::vector<int>>, boost::hash<std::pair<int, std::vector<int>>>> added_edges{};
+    added_edges.reserve(this->edges.size());
+    for (auto &edge : this->edges)
+    {
+        int parent_id{std::get<0>(edge)};
+        std::vector<int> &child_ids{std::get<1>(edge)};
+        std::sort(child_ids.begin(), child_ids.end());
+        child_ids.erase(std::unique(child_ids.begin(), child_ids.end()), child_ids.end());
+        if (!added_edges.insert(std::make_pair(parent_id, child_ids)).second)
+            continue; // the first of duplicate edges is kept, as add_edge does
+
+        std::vector<int> sorted_child_ids{child_ids};
+        graph.sort_children(sorted_child_ids);
+        graph.adjacency_list.at(parent_id).push_back(AndEdge{sorted_child_ids, std::get<2>(edge)});
+
+        for (int child_id : child_ids)
+        {
+            std::vector<int> &parents{graph.parent_ids.at(child_id)};
+            if (std::find(parents.begin(), parents.end(), parent_id) == parents.end())
+                parents.push_back(parent_id);
+        }
+    }
+
+    this->nodes.clear();
+    this->node_index.clear();
+    this->edges.clear();
+    return graph;
+}
+// BUILDER - END
\ No newline at end of file
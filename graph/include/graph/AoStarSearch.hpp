@@ -0,0 +1,98 @@
+#ifndef AO_STAR_SEARCH_HPP
+#define AO_STAR_SEARCH_HPP
+
+#include <cstddef>    // std::size_t
+#include <functional> // std::function
+#include <set>        // std::set
+#include <tuple>      // std::tuple
+#include <utility>    // std::pair
+#include <vector>     // std::vector
+
+#include <graph/FrozenAndOrGraph.hpp>
+
+// Solution tree of an AND-OR graph: the AND-edge chosen for every inner node of the tree, parents before children
+template <typename T>
+struct AoPlan
+{
+    double cost;
+    std::vector<std::tuple<T, std::vector<T>, int>> edges; // parent, children, edge id; as in AndOrGraph::get_edges
+};
+
+// Best-first AO* search for cost-minimal solution trees of a frozen AND-OR graph (see AndOrGraph::freeze()). Nodes
+// without AND-edges are solved at no cost, the cost of a tree is the sum of the costs of its AND-edges. Every child of
+// an AND-edge is counted once, hence graphs reduced by symmetries have to be expanded first (see
+// Assembly::get_expanded_ao_graph()).
+//
+// search() only expands the nodes the heuristic cannot rule out. With an admissible heuristic and a weight of 1 the
+// plan is optimal, with a weight w > 1 its cost is at most w times the optimum. search_k_best() needs exact costs for
+// every node below the root, hence it expands all of them and ignores the heuristic.
+template <typename T>
+class AoStarSearch
+{
+public:
+    // Cost of the AND-edge at index 'edge' of the frozen graph, leaving node 'node_id'; has to be non-negative
+    using CostFunction = std::function<double(const FrozenAndOrGraph<T> &graph, int node_id, std::size_t edge)>;
+    // Lower bound on the cost of solving node 'node_id'
+    using Heuristic = std::function<double(const FrozenAndOrGraph<T> &graph, int node_id)>;
+
+private:
+    static constexpr std::size_t no_edge{static_cast<std::size_t>(-1)};
+
+    // k-th best solution tree of a node: an AND-edge and the rank of the derivation used for every child
+    struct Derivation
+    {
+        double cost;
+        std::size_t edge; // no_edge for nodes without AND-edges
+        std::vector<int> ranks;
+
+        bool operator>(const Derivation &rhs) const;
+    };
+
+    const FrozenAndOrGraph<T> &graph; // borrowed, has to outlive the search
+    CostFunction cost;
+    Heuristic heuristic;
+    double weight;
+
+    std::vector<double> estimates; // cost estimate of every node, exact once the node is solved
+    std::vector<std::size_t> best_edges;
+    std::vector<bool> is_evaluated;
+    std::vector<bool> is_expanded;
+    std::vector<bool> is_solved;
+    std::vector<bool> is_queued;
+    std::vector<double> edge_costs; // cached, NaN until requested
+    std::size_t num_expanded;
+
+    std::vector<std::vector<Derivation>> derivations; // best first
+    std::vector<std::vector<Derivation>> candidates;  // min-heaps of the next derivations
+    std::vector<std::set<std::pair<std::size_t, std::vector<int>>>> candidate_keys;
+    std::vector<bool> has_candidates;
+
+    void reset();
+    bool is_leaf(int node_id) const;
+    double get_edge_cost(int node_id, std::size_t edge);
+
+    void evaluate(int node_id);
+    void expand(int node_id);
+    void revise(int node_id);
+    int find_tip(int root_id) const;
+
+    void push_candidate(int node_id, std::size_t edge, const std::vector<int> &ranks);
+    bool get_derivation(int node_id, std::size_t rank);
+    void append_plan(int node_id, std::size_t rank, AoPlan<T> &out) const;
+
+public:
+    explicit AoStarSearch(const FrozenAndOrGraph<T> &graph, const CostFunction &cost, const Heuristic &heuristic = Heuristic{}, double weight = 1.0);
+    ~AoStarSearch() = default;
+
+    // Returns false if the root is unknown or has no plan of finite cost
+    bool search(const T &root, AoPlan<T> &out);
+
+    // Up to 'k' plans in order of increasing cost
+    std::vector<AoPlan<T>> search_k_best(const T &root, std::size_t k);
+
+    std::size_t get_num_expanded() const; // nodes expanded by the last search
+};
+
+#include <graph/AoStarSearch.tpp>
+
+#endif // AO_STAR_SEARCH_HPP
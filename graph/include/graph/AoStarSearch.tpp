@@ -0,0 +1,343 @@
+#include <algorithm>  // std::pop_heap, std::push_heap
+#include <cmath>      // std::isnan
+#include <cstddef>    // std::size_t
+#include <deque>      // std::deque
+#include <functional> // std::greater
+#include <limits>     // std::numeric_limits
+#include <set>        // std::set
+#include <tuple>      // std::make_tuple, std::tuple
+#include <utility>    // std::make_pair, std::move, std::pair
+#include <vector>     // std::vector
+
+#include <graph/FrozenAndOrGraph.hpp>
+#include <graph/IdRange.hpp>
+
+template <typename T>
+bool AoStarSearch<T>::Derivation::operator>(const Derivation &rhs) const
+{
+    if (this->cost != rhs.cost)
+        return (this->cost > rhs.cost);
+    if (this->edge != rhs.edge)
+        return (this->edge > rhs.edge);
+    return (this->ranks > rhs.ranks);
+}
+
+template <typename T>
+AoStarSearch<T>::AoStarSearch(const FrozenAndOrGraph<T> &graph, const CostFunction &cost, const Heuristic &heuristic, double weight)
+    : graph{graph}, cost{cost}, heuristic{heuristic}, weight{weight},
+      estimates{}, best_edges{}, is_evaluated{}, is_expanded{}, is_solved{}, is_queued{}, edge_costs{}, num_expanded{0},
+      derivations{}, candidates{}, candidate_keys{}, has_candidates{}
+{
+}
+
+template <typename T>
+void AoStarSearch<T>::reset()
+{
+    std::size_t num_nodes{this->graph.get_num_nodes()};
+    this->estimates.assign(num_nodes, 0.0);
+    this->best_edges.assign(num_nodes, no_edge);
+    this->is_evaluated.assign(num_nodes, false);
+    this->is_expanded.assign(num_nodes, false);
+    this->is_solved.assign(num_nodes, false);
+    this->is_queued.assign(num_nodes, false);
+    this->edge_costs.assign(this->graph.get_num_edges(), std::numeric_limits<double>::quiet_NaN());
+    this->num_expanded = 0;
+
+    this->derivations.assign(num_nodes, std::vector<Derivation>{});
+    this->candidates.assign(num_nodes, std::vector<Derivation>{});
+    this->candidate_keys.assign(num_nodes, std::set<std::pair<std::size_t, std::vector<int>>>{});
+    this->has_candidates.assign(num_nodes, false);
+}
+
+template <typename T>
+bool AoStarSearch<T>::is_leaf(int node_id) const
+{
+    std::pair<std::size_t, std::size_t> edge_range{this->graph.get_edge_range(node_id)};
+    return (edge_range.first == edge_range.second);
+}
+
+template <typename T>
+double AoStarSearch<T>::get_edge_cost(int node_id, std::size_t edge)
+{
+    if (std::isnan(this->edge_costs.at(edge)))
+        this->edge_costs.at(edge) = this->cost(this->graph, node_id, edge);
+    return this->edge_costs.at(edge);
+}
+
+template <typename T>
+void AoStarSearch<T>::evaluate(int node_id)
+{
+    if (this->is_evaluated.at(node_id))
+        return;
+    this->is_evaluated.at(node_id) = true;
+
+    if (this->is_leaf(node_id))
+    {
+        this->is_expanded.at(node_id) = true;
+        this->is_solved.at(node_id) = true;
+    }
+    else if (this->heuristic)
+        this->estimates.at(node_id) = this->weight * this->heuristic(this->graph, node_id);
+}
+
+template <typename T>
+void AoStarSearch<T>::expand(int node_id)
+{
+    this->is_expanded.at(node_id) = true;
+    ++this->num_expanded;
+
+    std::pair<std::size_t, std::size_t> edge_range{this->graph.get_edge_range(node_id)};
+    for (std::size_t edge{edge_range.first}; edge < edge_range.second; ++edge)
+    {
+        for (int child_id : this->graph.get_child_ids(edge))
+            this->evaluate(child_id);
+    }
+}
+
+template <typename T>
+void AoStarSearch<T>::revise(int node_id)
+{
+    // Recomputes the estimates of the node and of its expanded ancestors until nothing changes anymore. The graph is
+    // acyclic, hence this terminates.
+    std::deque<int> open_ids{node_id};
+    this->is_queued.at(node_id) = true;
+
+    while (!open_ids.empty())
+    {
+        int open_id{open_ids.front()};
+        open_ids.pop_front();
+        this->is_queued.at(open_id) = false;
+
+        double estimate{std::numeric_limits<double>::infinity()};
+        std::size_t best_edge{no_edge};
+        std::pair<std::size_t, std::size_t> edge_range{this->graph.get_edge_range(open_id)};
+        for (std::size_t edge{edge_range.first}; edge < edge_range.second; ++edge)
+        {
+            double edge_estimate{this->get_edge_cost(open_id, edge)};
+            for (int child_id : this->graph.get_child_ids(edge))
+                edge_estimate += this->estimates.at(child_id);
+
+            if (edge_estimate < estimate)
+            {
+                estimate = edge_estimate;
+                best_edge = edge;
+            }
+        }
+
+        bool is_solved{best_edge != no_edge};
+        if (is_solved)
+        {
+            for (int child_id : this->graph.get_child_ids(best_edge))
+                is_solved = is_solved && this->is_solved.at(child_id);
+        }
+
+        if (estimate == this->estimates.at(open_id) && best_edge == this->best_edges.at(open_id) && is_solved == this->is_solved.at(open_id))
+            continue;
+
+        this->estimates.at(open_id) = estimate;
+        this->best_edges.at(open_id) = best_edge;
+        this->is_solved.at(open_id) = is_solved;
+
+        for (int parent_id : this->graph.get_parent_ids(open_id))
+        {
+            if (this->is_expanded.at(parent_id) && !this->is_queued.at(parent_id))
+            {
+                this->is_queued.at(parent_id) = true;
+                open_ids.push_back(parent_id);
+            }
+        }
+    }
+}
+
+template <typename T>
+int AoStarSearch<T>::find_tip(int root_id) const
+{
+    // first unexpanded node of the current best partial solution tree, in depth-first order
+    std::vector<int> open_ids{root_id};
+    while (!open_ids.empty())
+    {
+        int open_id{open_ids.back()};
+        open_ids.pop_back();
+
+        if (this->is_solved.at(open_id))
+            continue;
+        if (!this->is_expanded.at(open_id))
+            return open_id;
+        if (this->best_edges.at(open_id) == no_edge)
+            continue;
+
+        IdRange child_ids{this->graph.get_child_ids(this->best_edges.at(open_id))};
+        for (std::size_t i{child_ids.size()}; i > 0; --i)
+            open_ids.push_back(child_ids[i - 1]);
+    }
+    return -1;
+}
+
+template <typename T>
+void AoStarSearch<T>::push_candidate(int node_id, std::size_t edge, const std::vector<int> &ranks)
+{
+    if (!this->candidate_keys.at(node_id).insert(std::make_pair(edge, ranks)).second)
+        return;
+
+    IdRange child_ids{this->graph.get_child_ids(edge)};
+    double cost{this->get_edge_cost(node_id, edge)};
+    for (std::size_t i{0}; i < child_ids.size(); ++i)
+        cost += this->derivations.at(child_ids[i]).at(ranks.at(i)).cost;
+    if (cost == std::numeric_limits<double>::infinity())
+        return;
+
+    std::vector<Derivation> &node_candidates{this->candidates.at(node_id)};
+    node_candidates.push_back(Derivation{cost, edge, ranks});
+    std::push_heap(node_candidates.begin(), node_candidates.end(), std::greater<Derivation>{});
+}
+
+template <typename T>
+bool AoStarSearch<T>::get_derivation(int node_id, std::size_t rank)
+{
+    // Lazy k-best enumeration: the successors of a derivation (one child rank incremented) only become candidates
+    // once the derivation itself has been taken.
+    if (this->derivations.at(node_id).size() > rank)
+        return true;
+
+    if (this->is_leaf(node_id))
+    {
+        if (this->derivations.at(node_id).empty())
+            this->derivations.at(node_id).push_back(Derivation{0.0, no_edge, std::vector<int>{}});
+        return (rank == 0);
+    }
+
+    if (!this->has_candidates.at(node_id))
+    {
+        this->has_candidates.at(node_id) = true;
+        ++this->num_expanded;
+
+        std::pair<std::size_t, std::size_t> edge_range{this->graph.get_edge_range(node_id)};
+        for (std::size_t edge{edge_range.first}; edge < edge_range.second; ++edge)
+        {
+            IdRange child_ids{this->graph.get_child_ids(edge)};
+            bool is_derivable{true};
+            for (int child_id : child_ids)
+                is_derivable = is_derivable && this->get_derivation(child_id, 0);
+
+            if (is_derivable)
+                this->push_candidate(node_id, edge, std::vector<int>(child_ids.size(), 0));
+        }
+    }
+
+    while (this->derivations.at(node_id).size() <= rank)
+    {
+        if (!this->derivations.at(node_id).empty())
+        {
+            Derivation last{this->derivations.at(node_id).back()};
+            IdRange child_ids{this->graph.get_child_ids(last.edge)};
+            for (std::size_t i{0}; i < child_ids.size(); ++i)
+            {
+                std::vector<int> ranks{last.ranks};
+                ++ranks.at(i);
+                if (this->get_derivation(child_ids[i], ranks.at(i)))
+                    this->push_candidate(node_id, last.edge, ranks);
+            }
+        }
+
+        std::vector<Derivation> &node_candidates{this->candidates.at(node_id)};
+        if (node_candidates.empty())
+            return false;
+
+        std::pop_heap(node_candidates.begin(), node_candidates.end(), std::greater<Derivation>{});
+        this->derivations.at(node_id).push_back(std::move(node_candidates.back()));
+        node_candidates.pop_back();
+    }
+    return true;
+}
+
+template <typename T>
+void AoStarSearch<T>::append_plan(int node_id, std::size_t rank, AoPlan<T> &out) const
+{
+    const Derivation &derivation{this->derivations.at(node_id).at(rank)};
+    if (derivation.edge == no_edge)
+        return;
+
+    IdRange child_ids{this->graph.get_child_ids(derivation.edge)};
+    std::vector<T> child_data{};
+    for (int child_id : child_ids)
+        child_data.push_back(this->graph.get_node(child_id));
+    out.edges.push_back(std::make_tuple(this->graph.get_node(node_id), child_data, this->graph.get_edge_id(derivation.edge)));
+
+    for (std::size_t i{0}; i < child_ids.size(); ++i)
+        this->append_plan(child_ids[i], derivation.ranks.at(i), out);
+}
+
+template <typename T>
+bool AoStarSearch<T>::search(const T &root, AoPlan<T> &out)
+{
+    out = AoPlan<T>{0.0, {}};
+    this->reset();
+
+    int root_id{};
+    if (!this->graph.get_id(root, root_id))
+        return false;
+
+    this->evaluate(root_id);
+    while (!this->is_solved.at(root_id))
+    {
+        if (this->estimates.at(root_id) == std::numeric_limits<double>::infinity())
+            return false;
+
+        int tip_id{this->find_tip(root_id)};
+        if (tip_id == -1)
+            return false;
+
+        this->expand(tip_id);
+        this->revise(tip_id);
+    }
+    if (this->estimates.at(root_id) == std::numeric_limits<double>::infinity())
+        return false;
+
+    // the best edges of a solved node lead to solved children only
+    out.cost = this->estimates.at(root_id);
+    std::vector<int> open_ids{root_id};
+    while (!open_ids.empty())
+    {
+        int open_id{open_ids.back()};
+        open_ids.pop_back();
+
+        std::size_t best_edge{this->best_edges.at(open_id)};
+        if (best_edge == no_edge)
+            continue;
+
+        IdRange child_ids{this->graph.get_child_ids(best_edge)};
+        std::vector<T> child_data{};
+        for (int child_id : child_ids)
+            child_data.push_back(this->graph.get_node(child_id));
+        out.edges.push_back(std::make_tuple(this->graph.get_node(open_id), child_data, this->graph.get_edge_id(best_edge)));
+
+        for (std::size_t i{child_ids.size()}; i > 0; --i)
+            open_ids.push_back(child_ids[i - 1]);
+    }
+    return true;
+}
+
+template <typename T>
+std::vector<AoPlan<T>> AoStarSearch<T>::search_k_best(const T &root, std::size_t k)
+{
+    std::vector<AoPlan<T>> plans{};
+    this->reset();
+
+    int root_id{};
+    if (!this->graph.get_id(root, root_id))
+        return plans;
+
+    for (std::size_t rank{0}; rank < k && this->get_derivation(root_id, rank); ++rank)
+    {
+        AoPlan<T> plan{this->derivations.at(root_id).at(rank).cost, {}};
+        this->append_plan(root_id, rank, plan);
+        plans.push_back(std::move(plan));
+    }
+    return plans;
+}
+
+template <typename T>
+std::size_t AoStarSearch<T>::get_num_expanded() const
+{
+    return this->num_expanded;
+}
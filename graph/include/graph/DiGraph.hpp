@@ -1,13 +1,21 @@
 #ifndef DIGRAPH_HPP
 #define DIGRAPH_HPP
 
-#include <sstream> // std::stringstream
-#include <string>  // std::string
-#include <map>     // std::map
-#include <utility> // std::pair
-#include <vector>  // std::vector
+#include <cstddef>       // std::size_t
+#include <ostream>       // std::ostream
+#include <string>        // std::string
+#include <unordered_map> // std::unordered_map, std::unordered_multimap
+#include <utility>       // std::pair
+#include <vector>        // std::vector
 
+#include <boost/functional/hash.hpp>
+
+#include <graph/FrozenDiGraph.hpp>
+#include <graph/IdRange.hpp>
+
+#include <plot/DotOptions.hpp>
 #include <plot/I_Plotable.hpp>
+#include <plot/PlotService.hpp>
 
 template <typename N, typename E = int>
 class DiGraph : public I_Plotable
@@ -16,26 +24,91 @@ private:
     static constexpr char def_name[] = "directional_graph";
     std::string name;
 
-    std::map<int, std::vector<int>> adjacency_list;
-    std::map<int, N> node_ids;
-    std::map<int, std::pair<N, N>> edge_ids;
-    std::map<int, E> edge_attrs;
-    std::map<int, E> edge_attr_ids;
+    // Node and edge attribute payloads are stored once, everything else refers to them by id
+    std::vector<N> nodes;                   // indexed by node id
+    std::vector<E> edge_attrs;              // distinct edge attributes, indexed by edge attribute id
+    std::vector<std::pair<int, int>> edges; // (source id, target id), indexed by edge id
+    std::vector<int> edge_attr_ids;         // edge attribute id of every edge
 
-    std::vector<N> nodes;
+    std::vector<std::vector<int>> adjacency_list;   // out-edges
+    std::vector<std::vector<int>> predecessor_list; // in-edges
+
+    // Hash indexes (hash of the payload -> ids sharing that hash); edges are keyed by the ids of their nodes
+    std::unordered_multimap<std::size_t, int> node_index;
+    std::unordered_map<std::pair<int, int>, int, boost::hash<std::pair<int, int>>> edge_index;
+    std::unordered_multimap<std::size_t, int> edge_attr_index;
 
-    bool get_id(const N &node, int &out) const;
     bool get_id(const std::pair<N, N> &edge, int &out) const;
     bool get_id(const E &edge_attr, int &out) const;
 
     void add_node(const N &node, int &out_id);
 
 public:
+    // Read-only view of the graph with every edge reversed. It shares the storage of the viewed graph, which has
+    // to outlive the view. Successors and root nodes are listed in the order of reverse(), everything else in the
+    // order of the viewed graph.
+    class ReverseView
+    {
+    private:
+        const DiGraph<N, E> &graph;
+
+    public:
+        explicit ReverseView(const DiGraph<N, E> &graph);
+        ~ReverseView() = default;
+
+        const std::vector<N> &get_nodes() const;
+        std::vector<std::pair<N, N>> get_edges() const;
+
+        std::vector<N> get_successors(const N &node) const;
+        std::vector<N> get_predecessors(const N &node) const;
+
+        std::vector<N> get_root_nodes() const;
+        std::vector<N> get_leaf_nodes() const;
+
+        E get_edge_attr(const std::pair<N, N> &edge) const;
+    };
+
+    // Batch construction: nodes and edge attributes are interned as they are added and moved into the graph, duplicate
+    // edges are dropped in a single hash pass on build(). The result is identical to adding the same edges one by one.
+    class Builder
+    {
+    private:
+        std::string name;
+        std::vector<N> nodes;
+        std::unordered_multimap<std::size_t, int> node_index;
+        std::vector<std::pair<int, int>> edges;
+        std::vector<E> edge_attrs;      // distinct attributes of the added edges
+        std::vector<int> edge_attr_ids; // attribute of every added edge, as an id of this builder
+        std::unordered_multimap<std::size_t, int> edge_attr_index;
+
+        int intern(N &&node);
+        int intern_edge_attr(E &&edge_attr);
+
+    public:
+        explicit Builder(const std::string &name = def_name);
+        ~Builder() = default;
+
+        void reserve(std::size_t num_nodes, std::size_t num_edges);
+        void add_edge(N u, N v, E edge_attr = E{});
+
+        DiGraph<N, E> build();
+    };
+
     DiGraph(const std::string &name = def_name);
     explicit DiGraph(const std::vector<std::pair<N, N>> &edges, const std::string &name = def_name);
     ~DiGraph() = default;
 
-    std::vector<N> get_nodes() const;
+    // id based access, node ids are the positions in get_nodes()
+    bool get_id(const N &node, int &out) const;
+    const N &get_node(int node_id) const;
+
+    IdRange get_successor_ids(int node_id) const;                 // in insertion order
+    IdRange get_predecessor_ids(int node_id) const;               // in insertion order
+    const std::vector<std::pair<int, int>> &get_edge_ids() const; // (source id, target id), in insertion order
+    const std::vector<int> &get_edge_attr_ids() const;            // parallel to get_edge_ids
+
+    // value based access
+    const std::vector<N> &get_nodes() const;
     std::vector<std::pair<N, N>> get_edges() const;
 
     std::vector<N> get_successors(const N &node) const;
@@ -45,18 +118,20 @@ public:
     std::vector<N> get_leaf_nodes() const;
 
     E get_edge_attr(const std::pair<N, N> &edge) const;
-    std::vector<E> get_edge_attrs() const;
+    const std::vector<E> &get_edge_attrs() const;
 
     void add_edge(const N &u, const N &v, const E &edge_attr = E{});
     void add_edges(const std::vector<std::pair<N, N>> &edges);
 
     DiGraph<N, E> reverse() const;
+    ReverseView reverse_view() const;
+    FrozenDiGraph<N, E> freeze() const;
 
     std::string get_name() const override;
     void set_name(const std::string &name);
 
-    std::stringstream generate_dot() const override;
-    void plot(const std::string &output_loc) const;
+    void write_dot(std::ostream &os, const DotOptions &options) const override;
+    void plot(PlotService &plot_service, const std::string &output_loc, PlotFormat format = PlotFormat::png, const DotOptions &options = DotOptions{}) const;
 };
 
 #include <graph/DiGraph.tpp>
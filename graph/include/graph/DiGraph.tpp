@@ -1,20 +1,26 @@
-#include <algorithm> // std::copy_if, std::find, std::find_if, std::for_each, std::transform
-#include <iterator>  // std::back_inserter
-#include <map>       // std::map
-#include <memory>    // std::make_shared, std::shared_ptr
-#include <sstream>   // std::stringstream
-#include <string>    // std::string
-#include <utility>   // std::make_pair, std::pair
-#include <vector>    // std::vector
-
+#include <algorithm>     // std::for_each, std::sort
+#include <cstddef>       // std::size_t
+#include <functional>    // std::hash
+#include <ostream>       // std::ostream
+#include <string>        // std::string
+#include <tuple>         // std::make_tuple, std::tuple
+#include <unordered_map> // std::unordered_map, std::unordered_multimap
+#include <utility>       // std::make_pair, std::move, std::pair
+#include <vector>        // std::vector
+
+#include <graph/FrozenDiGraph.hpp>
+#include <graph/IdRange.hpp>
+
+#include <plot/DotOptions.hpp>
 #include <plot/I_Plotable.hpp>
-#include <plot/Plotter.hpp>
+#include <plot/PlotService.hpp>
 
 #include <utils/utils.hpp> // utils::to_snake_case
 
 template <typename N, typename E>
 DiGraph<N, E>::DiGraph(const std::string &name)
-    : name{name}, adjacency_list{}, node_ids{}, edge_ids{}, edge_attrs{}, nodes{}
+    : name{name}, nodes{}, edge_attrs{}, edges{}, edge_attr_ids{}, adjacency_list{}, predecessor_list{},
+      node_index{}, edge_index{}, edge_attr_index{}
 {
 }
 
@@ -28,61 +34,54 @@ DiGraph<N, E>::DiGraph(const std::vector<std::pair<N, N>> &edges, const std::str
 template <typename N, typename E>
 bool DiGraph<N, E>::get_id(const N &node, int &out) const
 {
-    auto it = std::find_if(this->node_ids.begin(), this->node_ids.end(),
-                           [&node](const auto &n) {
-                               return (n.second == node);
-                           });
-
-    if (it != node_ids.end())
-    {
-        out = it->first;
-        return true;
-    }
-    else
+    auto range = this->node_index.equal_range(std::hash<N>{}(node));
+    for (auto it = range.first; it != range.second; ++it)
     {
-        out = this->node_ids.size();
-        return false;
+        if (this->nodes.at(it->second) == node)
+        {
+            out = it->second;
+            return true;
+        }
     }
+
+    out = this->nodes.size();
+    return false;
 }
 
 template <typename N, typename E>
 bool DiGraph<N, E>::get_id(const std::pair<N, N> &edge, int &out) const
 {
-    auto it = std::find_if(this->edge_ids.begin(), this->edge_ids.end(),
-                           [&edge](const auto &e) {
-                               return (e.second == edge);
-                           });
-
-    if (it != edge_ids.end())
-    {
-        out = it->first;
-        return true;
-    }
-    else
+    int u_id{};
+    int v_id{};
+    if (this->get_id(edge.first, u_id) && this->get_id(edge.second, v_id))
     {
-        out = this->edge_ids.size();
-        return false;
+        auto it = this->edge_index.find(std::make_pair(u_id, v_id));
+        if (it != this->edge_index.end())
+        {
+            out = it->second;
+            return true;
+        }
     }
+
+    out = this->edges.size();
+    return false;
 }
 
 template <typename N, typename E>
 bool DiGraph<N, E>::get_id(const E &edge_attr, int &out) const
 {
-    auto it = std::find_if(this->edge_attr_ids.begin(), this->edge_attr_ids.end(),
-                           [&edge_attr](const auto &e) {
-                               return (e.second == edge_attr);
-                           });
-
-    if (it != edge_attr_ids.end())
+    auto range = this->edge_attr_index.equal_range(std::hash<E>{}(edge_attr));
+    for (auto it = range.first; it != range.second; ++it)
     {
-        out = it->first;
-        return true;
-    }
-    else
-    {
-        out = this->edge_attr_ids.size();
-        return false;
+        if (this->edge_attrs.at(it->second) == edge_attr)
+        {
+            out = it->second;
+            return true;
+        }
     }
+
+    out = this->edge_attrs.size();
+    return false;
 }
 
 template <typename N, typename E>
@@ -90,29 +89,59 @@ void DiGraph<N, E>::add_node(const N &node, int &out_id)
 {
     if (!this->get_id(node, out_id))
     {
-        this->node_ids.emplace(std::make_pair(out_id, node));
-        this->adjacency_list.emplace(std::make_pair(out_id, std::vector<int>{}));
-
         this->nodes.push_back(node);
+        this->node_index.emplace(std::make_pair(std::hash<N>{}(node), out_id));
+        this->adjacency_list.push_back(std::vector<int>{});
+        this->predecessor_list.push_back(std::vector<int>{});
     }
 }
 
 template <typename N, typename E>
-std::vector<N> DiGraph<N, E>::get_nodes() const
+const N &DiGraph<N, E>::get_node(int node_id) const
+{
+    return this->nodes.at(node_id);
+}
+
+template <typename N, typename E>
+IdRange DiGraph<N, E>::get_successor_ids(int node_id) const
+{
+    const std::vector<int> &successor_ids{this->adjacency_list.at(node_id)};
+    return IdRange{successor_ids.data(), successor_ids.data() + successor_ids.size()};
+}
+
+template <typename N, typename E>
+IdRange DiGraph<N, E>::get_predecessor_ids(int node_id) const
+{
+    const std::vector<int> &predecessor_ids{this->predecessor_list.at(node_id)};
+    return IdRange{predecessor_ids.data(), predecessor_ids.data() + predecessor_ids.size()};
+}
+
+template <typename N, typename E>
+const std::vector<std::pair<int, int>> &DiGraph<N, E>::get_edge_ids() const
+{
+    return this->edges;
+}
+
+template <typename N, typename E>
+const std::vector<int> &DiGraph<N, E>::get_edge_attr_ids() const
+{
+    return this->edge_attr_ids;
+}
+
+template <typename N, typename E>
+const std::vector<N> &DiGraph<N, E>::get_nodes() const
 {
-    std::vector<N> nodes{};
-    std::transform(this->node_ids.begin(), this->node_ids.end(), std::back_inserter(nodes),
-                   [](const auto &node_id) { return node_id.second; });
-    return nodes;
+    return this->nodes;
 }
 
 template <typename N, typename E>
 std::vector<std::pair<N, N>> DiGraph<N, E>::get_edges() const
 {
-    std::vector<std::pair<N, N>> edges{};
-    std::transform(this->edge_ids.begin(), this->edge_ids.end(), std::back_inserter(edges),
-                   [](const auto &edge_id) { return edge_id.second; });
-    return edges;
+    std::vector<std::pair<N, N>> edges_data{};
+    edges_data.reserve(this->edges.size());
+    for (const auto &edge : this->edges)
+        edges_data.push_back(std::make_pair(this->nodes.at(edge.first), this->nodes.at(edge.second)));
+    return edges_data;
 }
 
 template <typename N, typename E>
@@ -124,11 +153,7 @@ std::vector<N> DiGraph<N, E>::get_successors(const N &node) const
     if (this->get_id(node, node_id))
     {
         for (int successor_id : this->adjacency_list.at(node_id))
-        {
-            auto it = node_ids.find(successor_id);
-            if (it != node_ids.end())
-                successors.push_back(it->second);
-        }
+            successors.push_back(this->nodes.at(successor_id));
     }
 
     return successors;
@@ -142,15 +167,11 @@ std::vector<N> DiGraph<N, E>::get_predecessors(const N &node) const
     int node_id{};
     if (this->get_id(node, node_id))
     {
-        for (const auto &adj : this->adjacency_list)
-        {
-            if (std::find(adj.second.begin(), adj.second.end(), node_id) != adj.second.end())
-            {
-                auto it = node_ids.find(adj.first);
-                if (it != node_ids.end())
-                    predecessors.push_back(it->second);
-            }
-        }
+        // in order of node ids, as the successors are scanned
+        std::vector<int> predecessor_ids{this->predecessor_list.at(node_id)};
+        std::sort(predecessor_ids.begin(), predecessor_ids.end());
+        for (int predecessor_id : predecessor_ids)
+            predecessors.push_back(this->nodes.at(predecessor_id));
     }
 
     return predecessors;
@@ -160,8 +181,11 @@ template <typename N, typename E>
 std::vector<N> DiGraph<N, E>::get_root_nodes() const
 {
     std::vector<N> root_nodes{};
-    std::copy_if(this->nodes.begin(), this->nodes.end(), std::back_inserter(root_nodes),
-                 [this](const N &node) { return this->get_predecessors(node).empty(); });
+    for (size_t id{0}; id < this->nodes.size(); ++id)
+    {
+        if (this->predecessor_list.at(id).empty())
+            root_nodes.push_back(this->nodes.at(id));
+    }
     return root_nodes;
 }
 
@@ -169,8 +193,11 @@ template <typename N, typename E>
 std::vector<N> DiGraph<N, E>::get_leaf_nodes() const
 {
     std::vector<N> leaf_nodes{};
-    std::copy_if(this->nodes.begin(), this->nodes.end(), std::back_inserter(leaf_nodes),
-                 [this](const N &node) { return this->get_successors(node).empty(); });
+    for (size_t id{0}; id < this->nodes.size(); ++id)
+    {
+        if (this->adjacency_list.at(id).empty())
+            leaf_nodes.push_back(this->nodes.at(id));
+    }
     return leaf_nodes;
 }
 
@@ -181,18 +208,15 @@ E DiGraph<N, E>::get_edge_attr(const std::pair<N, N> &edge) const
     int edge_id{};
     if (this->get_id(edge, edge_id))
     {
-        edge_attr = this->edge_attrs.at(edge_id);
+        edge_attr = this->edge_attrs.at(this->edge_attr_ids.at(edge_id));
     }
     return edge_attr;
 }
 
 template <typename N, typename E>
-std::vector<E> DiGraph<N, E>::get_edge_attrs() const
+const std::vector<E> &DiGraph<N, E>::get_edge_attrs() const
 {
-    std::vector<E> edge_attrs{};
-    std::transform(this->edge_attr_ids.begin(), this->edge_attr_ids.end(), std::back_inserter(edge_attrs),
-                   [](const auto &edge_attr_id) { return edge_attr_id.second; });
-    return edge_attrs;
+    return this->edge_attrs;
 }
 
 template <typename N, typename E>
@@ -204,22 +228,22 @@ void DiGraph<N, E>::add_edge(const N &u, const N &v, const E &edge_attr)
     int v_id{};
     this->add_node(v, v_id);
 
-    auto it = this->adjacency_list.find(u_id);
-    if (std::find(it->second.begin(), it->second.end(), v_id) == it->second.end())
+    if (this->edge_index.find(std::make_pair(u_id, v_id)) == this->edge_index.end())
     {
-        it->second.push_back(v_id);
+        this->adjacency_list.at(u_id).push_back(v_id);
 
-        std::pair<N, N> edge{std::make_pair(u, v)};
-        int edge_id{};
-        if (!this->get_id(edge, edge_id))
-        {
-            this->edge_ids.emplace(std::make_pair(edge_id, edge));
-            this->edge_attrs.emplace(std::make_pair(edge_id, edge_attr));
+        this->predecessor_list.at(v_id).push_back(u_id);
 
-            int edge_attr_id{};
-            if (!this->get_id(edge_attr, edge_attr_id))
-                this->edge_attr_ids.emplace(std::make_pair(edge_attr_id, edge_attr));
+        int edge_attr_id{};
+        if (!this->get_id(edge_attr, edge_attr_id))
+        {
+            this->edge_attrs.push_back(edge_attr);
+            this->edge_attr_index.emplace(std::make_pair(std::hash<E>{}(edge_attr), edge_attr_id));
         }
+
+        this->edge_index.emplace(std::make_pair(std::make_pair(u_id, v_id), static_cast<int>(this->edges.size())));
+        this->edges.push_back(std::make_pair(u_id, v_id));
+        this->edge_attr_ids.push_back(edge_attr_id);
     }
 }
 
@@ -236,15 +260,36 @@ DiGraph<N, E> DiGraph<N, E>::reverse() const
 {
     DiGraph<N, E> reversed_graph{};
 
-    std::for_each(this->edge_ids.begin(), this->edge_ids.end(),
-                  [this, &reversed_graph](const auto &e) {
-                      std::pair<N, N> edge{e.second};
-                      reversed_graph.add_edge(edge.second, edge.first, this->edge_attrs.at(e.first));
-                  });
+    for (size_t edge_id{0}; edge_id < this->edges.size(); ++edge_id)
+    {
+        const std::pair<int, int> &edge{this->edges.at(edge_id)};
+        reversed_graph.add_edge(this->nodes.at(edge.second), this->nodes.at(edge.first), this->edge_attrs.at(this->edge_attr_ids.at(edge_id)));
+    }
 
     return reversed_graph;
 }
 
+template <typename N, typename E>
+typename DiGraph<N, E>::ReverseView DiGraph<N, E>::reverse_view() const
+{
+    return ReverseView{*this};
+}
+
+template <typename N, typename E>
+FrozenDiGraph<N, E> DiGraph<N, E>::freeze() const
+{
+    // in insertion order, which the frozen graph keeps for the out- and in-edges of every node
+    std::vector<std::tuple<int, int, int>> frozen_edges{};
+    frozen_edges.reserve(this->edges.size());
+    for (size_t edge_id{0}; edge_id < this->edges.size(); ++edge_id)
+    {
+        const std::pair<int, int> &edge{this->edges.at(edge_id)};
+        frozen_edges.push_back(std::make_tuple(edge.first, edge.second, this->edge_attr_ids.at(edge_id)));
+    }
+
+    return FrozenDiGraph<N, E>{this->nodes, this->edge_attrs, frozen_edges};
+}
+
 template <typename N, typename E>
 std::string DiGraph<N, E>::get_name() const
 {
@@ -258,59 +303,259 @@ void DiGraph<N, E>::set_name(const std::string &name)
 }
 
 template <typename N, typename E>
-std::stringstream DiGraph<N, E>::generate_dot() const
+void DiGraph<N, E>::write_dot(std::ostream &os, const DotOptions &options) const
 {
-    std::stringstream ss_dot{};
+    std::vector<int> root_ids{};
+    for (size_t id{0}; id < this->nodes.size(); ++id)
+    {
+        if (this->predecessor_list.at(id).empty())
+            root_ids.push_back(id);
+    }
+    std::vector<bool> is_written{options.select_nodes(this->adjacency_list, root_ids)};
 
-    ss_dot << "/*"
+    if (options.with_payloads)
+    {
+        os << "/*"
            << "\n=== NODES ===";
-    std::for_each(this->node_ids.begin(), this->node_ids.end(),
-                  [&ss_dot](const std::pair<int, N> &p) {
-                      ss_dot << '\n'
-                             << p.first << ":\n"
-                             << p.second << '\n';
-                  });
-
-    if (this->edge_attr_ids.size() > 1)
+        for (size_t id{0}; id < this->nodes.size(); ++id)
+        {
+            if (!is_written.at(id))
+                continue;
+
+            os << '\n'
+               << id << ":\n"
+               << this->nodes.at(id) << '\n';
+        }
+
+        if (this->edge_attrs.size() > 1)
+        {
+            os << "\n=== EDGES ===";
+            for (size_t id{0}; id < this->edge_attrs.size(); ++id)
+            {
+                os << '\n'
+                   << id << ":\n"
+                   << this->edge_attrs.at(id) << '\n';
+            }
+        }
+        os << "*/\n";
+    }
+
+    os << '\n'
+       << "digraph " << utils::to_snake_case(this->get_name())
+       << "{\n";
+    std::vector<size_t> num_hidden_successors(this->nodes.size(), 0);
+    for (size_t edge_id{0}; edge_id < this->edges.size(); ++edge_id)
     {
-        ss_dot << "\n=== EDGES ===";
-        std::for_each(this->edge_attr_ids.begin(), this->edge_attr_ids.end(),
-                      [&ss_dot](const std::pair<int, E> &p) {
-                          ss_dot << '\n'
-                                 << p.first << ":\n"
-                                 << p.second << '\n';
-                      });
+        const std::pair<int, int> &edge{this->edges.at(edge_id)};
+        if (!is_written.at(edge.first))
+            continue;
+        if (!is_written.at(edge.second))
+        {
+            ++num_hidden_successors.at(edge.first);
+            continue;
+        }
+
+        os << edge.first << " -> " << edge.second;
+        if (this->edge_attrs.size() > 1)
+            os << " [label = " << this->edge_attr_ids.at(edge_id) << "]";
+        os << '\n';
+    }
+    for (size_t id{0}; id < this->nodes.size(); ++id)
+    {
+        if (num_hidden_successors.at(id) == 0)
+            continue;
+
+        os << "collapsed_" << id << " [label = \"" << num_hidden_successors.at(id) << " more\", shape = plaintext]\n"
+           << id << " -> collapsed_" << id << " [style = dashed]\n";
     }
-    ss_dot << "*/\n";
+    os << "}\n";
+}
+
+template <typename N, typename E>
+void DiGraph<N, E>::plot(PlotService &plot_service, const std::string &output_loc, PlotFormat format, const DotOptions &options) const
+{
+    plot_service.submit(*this, output_loc, format, options);
+}
+
+// REVERSE VIEW - BEGIN
+template <typename N, typename E>
+DiGraph<N, E>::ReverseView::ReverseView(const DiGraph<N, E> &graph)
+    : graph{graph}
+{
+}
+
+template <typename N, typename E>
+const std::vector<N> &DiGraph<N, E>::ReverseView::get_nodes() const
+{
+    return this->graph.get_nodes();
+}
+
+template <typename N, typename E>
+std::vector<std::pair<N, N>> DiGraph<N, E>::ReverseView::get_edges() const
+{
+    std::vector<std::pair<N, N>> edges_data{};
+    edges_data.reserve(this->graph.edges.size());
+    for (const auto &edge : this->graph.edges)
+        edges_data.push_back(std::make_pair(this->graph.nodes.at(edge.second), this->graph.nodes.at(edge.first)));
+    return edges_data;
+}
 
-    ss_dot << '\n'
-           << "digraph " << utils::to_snake_case(this->get_name())
-           << "{\n";
-    for (const std::pair<int, std::pair<N, N>> &p : this->edge_ids)
+template <typename N, typename E>
+std::vector<N> DiGraph<N, E>::ReverseView::get_successors(const N &node) const
+{
+    std::vector<N> successors{};
+
+    int node_id{};
+    if (this->graph.get_id(node, node_id))
     {
-        int u_id{};
-        int v_id{};
-        int edge_attr_id{};
+        for (int successor_id : this->graph.predecessor_list.at(node_id))
+            successors.push_back(this->graph.nodes.at(successor_id));
+    }
 
-        this->get_id(p.second.first, u_id);
-        this->get_id(p.second.second, v_id);
-        this->get_id(this->edge_attrs.at(p.first), edge_attr_id);
+    return successors;
+}
 
-        ss_dot << u_id << " -> " << v_id;
-        if (this->edge_attr_ids.size() > 1)
-            ss_dot << " [label = " << edge_attr_id << "]";
-        ss_dot << '\n';
+template <typename N, typename E>
+std::vector<N> DiGraph<N, E>::ReverseView::get_predecessors(const N &node) const
+{
+    return this->graph.get_successors(node);
+}
+
+template <typename N, typename E>
+std::vector<N> DiGraph<N, E>::ReverseView::get_root_nodes() const
+{
+    // reverse() adds the target and then the source of every edge, in insertion order
+    std::vector<N> root_nodes{};
+    std::vector<bool> is_visited(this->graph.nodes.size(), false);
+    for (const std::pair<int, int> &edge : this->graph.edges)
+    {
+        for (int id : {edge.second, edge.first})
+        {
+            if (is_visited.at(id))
+                continue;
+            is_visited.at(id) = true;
+
+            if (this->graph.adjacency_list.at(id).empty())
+                root_nodes.push_back(this->graph.nodes.at(id));
+        }
     }
-    ss_dot << "}\n";
+    return root_nodes;
+}
+
+template <typename N, typename E>
+std::vector<N> DiGraph<N, E>::ReverseView::get_leaf_nodes() const
+{
+    return this->graph.get_root_nodes();
+}
 
-    return ss_dot;
+template <typename N, typename E>
+E DiGraph<N, E>::ReverseView::get_edge_attr(const std::pair<N, N> &edge) const
+{
+    return this->graph.get_edge_attr(std::make_pair(edge.second, edge.first));
+}
+// REVERSE VIEW - END
+
+// BUILDER - BEGIN
+template <typename N, typename E>
+DiGraph<N, E>::Builder::Builder(const std::string &name)
+    : name{name}, nodes{}, node_index{}, edges{}, edge_attrs{}, edge_attr_ids{}, edge_attr_index{}
+{
 }
 
 template <typename N, typename E>
-void DiGraph<N, E>::plot(const std::string &output_loc) const
+int DiGraph<N, E>::Builder::intern(N &&node)
 {
-    std::shared_ptr<I_Plotable> digraph_ptr = std::make_shared<DiGraph<N, E>>(*this);
-    Plotter plotter{digraph_ptr, output_loc};
-    plotter.generate_dot();
-    plotter.render_dot();
-}
\ No newline at end of file
+    std::size_t hash{std::hash<N>{}(node)};
+    auto range = this->node_index.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (this->nodes.at(it->second) == node)
+            return it->second;
+    }
+
+    int node_id{static_cast<int>(this->nodes.size())};
+    this->nodes.push_back(std::move(node));
+    this->node_index.emplace(std::make_pair(hash, node_id));
+    return node_id;
+}
+
+template <typename N, typename E>
+int DiGraph<N, E>::Builder::intern_edge_attr(E &&edge_attr)
+{
+    std::size_t hash{std::hash<E>{}(edge_attr)};
+    auto range = this->edge_attr_index.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (this->edge_attrs.at(it->second) == edge_attr)
+            return it->second;
+    }
+
+    int edge_attr_id{static_cast<int>(this->edge_attrs.size())};
+    this->edge_attrs.push_back(std::move(edge_attr));
+    this->edge_attr_index.emplace(std::make_pair(hash, edge_attr_id));
+    return edge_attr_id;
+}
+
+template <typename N, typename E>
+void DiGraph<N, E>::Builder::reserve(std::size_t num_nodes, std::size_t num_edges)
+{
+    this->nodes.reserve(num_nodes);
+    this->node_index.reserve(num_nodes);
+    this->edges.reserve(num_edges);
+    this->edge_attr_ids.reserve(num_edges);
+}
+
+template <typename N, typename E>
+void DiGraph<N, E>::Builder::add_edge(N u, N v, E edge_attr)
+{
+    int u_id{this->intern(std::move(u))};
+    int v_id{this->intern(std::move(v))};
+    this->edges.push_back(std::make_pair(u_id, v_id));
+    this->edge_attr_ids.push_back(this->intern_edge_attr(std::move(edge_attr)));
+}
+
+template <typename N, typename E>
+DiGraph<N, E> DiGraph<N, E>::Builder::build()
+{
+    DiGraph<N, E> graph{this->name};
+    graph.nodes = std::move(this->nodes);
+    graph.node_index = std::move(this->node_index);
+    graph.adjacency_list.resize(graph.nodes.size());
+    graph.predecessor_list.resize(graph.nodes.size());
+
+    graph.edges.reserve(this->edges.size());
+    graph.edge_attr_ids.reserve(this->edges.size());
+    graph.edge_index.reserve(this->edges.size());
+
+    // attributes are numbered by their first kept edge, as add_edge does; attributes of dropped edges only are dropped
+    std::vector<int> graph_attr_ids(this->edge_attrs.size(), -1);
+    for (size_t i{0}; i < this->edges.size(); ++i)
+    {
+        const std::pair<int, int> &edge{this->edges.at(i)};
+        if (!graph.edge_index.emplace(std::make_pair(edge, static_cast<int>(graph.edges.size()))).second)
+            continue; // the first of duplicate edges is kept, as add_edge does
+
+        int &edge_attr_id{graph_attr_ids.at(this->edge_attr_ids.at(i))};
+        if (edge_attr_id < 0)
+        {
+            edge_attr_id = static_cast<int>(graph.edge_attrs.size());
+            E &edge_attr{this->edge_attrs.at(this->edge_attr_ids.at(i))};
+            graph.edge_attr_index.emplace(std::make_pair(std::hash<E>{}(edge_attr), edge_attr_id));
+            graph.edge_attrs.push_back(std::move(edge_attr));
+        }
+
+        graph.edges.push_back(edge);
+        graph.edge_attr_ids.push_back(edge_attr_id);
+        graph.adjacency_list.at(edge.first).push_back(edge.second);
+        graph.predecessor_list.at(edge.second).push_back(edge.first);
+    }
+
+    this->nodes.clear();
+    this->node_index.clear();
+    this->edges.clear();
+    this->edge_attrs.clear();
+    this->edge_attr_ids.clear();
+    this->edge_attr_index.clear();
+    return graph;
+}
+// BUILDER - END
\ No newline at end of file
@@ -0,0 +1,60 @@
+#ifndef FROZEN_AND_OR_GRAPH_HPP
+#define FROZEN_AND_OR_GRAPH_HPP
+
+#include <cstddef>       // std::size_t
+#include <tuple>         // std::tuple
+#include <unordered_map> // std::unordered_multimap
+#include <utility>       // std::pair
+#include <vector>        // std::vector
+
+#include <graph/IdRange.hpp>
+
+// Immutable compressed-sparse-row snapshot of an AndOrGraph, created by AndOrGraph::freeze(). Node ids are dense and
+// equal to the ids of the source graph. The AND-edges of node i are [edge_offsets[i], edge_offsets[i + 1]), the
+// children of AND-edge e are stored at [child_offsets[e], child_offsets[e + 1]) of the child id array.
+template <typename T>
+class FrozenAndOrGraph
+{
+private:
+    std::vector<T> nodes;                                 // indexed by node id
+    std::unordered_multimap<std::size_t, int> node_index; // hash of the node data -> ids sharing that hash
+
+    std::vector<std::size_t> edge_offsets;
+    std::vector<int> edge_ids; // id of every AND-edge, as passed to AndOrGraph::add_edge
+    std::vector<std::size_t> child_offsets;
+    std::vector<int> child_ids;
+
+    std::vector<std::size_t> parent_offsets;
+    std::vector<int> parent_ids; // sorted by node id
+
+public:
+    FrozenAndOrGraph();
+    explicit FrozenAndOrGraph(const std::vector<T> &nodes, const std::vector<std::tuple<int, std::vector<int>, int>> &edges);
+    ~FrozenAndOrGraph() = default;
+
+    std::size_t get_num_nodes() const;
+    std::size_t get_num_edges() const;
+
+    // id based access
+    bool get_id(const T &data, int &out) const;
+    const T &get_node(int node_id) const;
+
+    std::pair<std::size_t, std::size_t> get_edge_range(int node_id) const; // [first, last) AND-edges of the node
+    int get_edge_id(std::size_t edge) const;
+    IdRange get_child_ids(std::size_t edge) const;
+    IdRange get_parent_ids(int node_id) const;
+
+    // value based access, same semantics as AndOrGraph
+    const std::vector<T> &get_nodes() const;
+    std::vector<std::tuple<T, std::vector<T>, int>> get_edges() const;
+
+    std::vector<std::vector<T>> get_successors(const T &data) const;
+    std::vector<T> get_predecessors(const T &data) const;
+
+    std::vector<T> get_root_nodes() const;
+    std::vector<T> get_leaf_nodes() const;
+};
+
+#include <graph/FrozenAndOrGraph.tpp>
+
+#endif // FROZEN_AND_OR_GRAPH_HPP
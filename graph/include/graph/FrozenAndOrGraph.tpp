@@ -0,0 +1,197 @@
+#include <algorithm>     // std::sort, std::unique
+#include <cstddef>       // std::size_t
+#include <functional>    // std::hash
+#include <tuple>         // std::get, std::make_tuple, std::tuple
+#include <unordered_map> // std::unordered_multimap
+#include <utility>       // std::make_pair, std::pair
+#include <vector>        // std::vector
+
+#include <graph/IdRange.hpp>
+
+template <typename T>
+FrozenAndOrGraph<T>::FrozenAndOrGraph()
+    : nodes{}, node_index{}, edge_offsets{0}, edge_ids{}, child_offsets{0}, child_ids{}, parent_offsets{0}, parent_ids{}
+{
+}
+
+template <typename T>
+FrozenAndOrGraph<T>::FrozenAndOrGraph(const std::vector<T> &nodes, const std::vector<std::tuple<int, std::vector<int>, int>> &edges)
+    : nodes{nodes}, node_index{}, edge_offsets(nodes.size() + 1, 0), edge_ids{}, child_offsets{0}, child_ids{},
+      parent_offsets(nodes.size() + 1, 0), parent_ids{}
+{
+    this->node_index.reserve(this->nodes.size());
+    for (std::size_t id{0}; id < this->nodes.size(); ++id)
+        this->node_index.emplace(std::make_pair(std::hash<T>{}(this->nodes.at(id)), static_cast<int>(id)));
+
+    // edges are expected to be grouped by parent id in increasing order
+    this->edge_ids.reserve(edges.size());
+    this->child_offsets.reserve(edges.size() + 1);
+    std::vector<std::pair<int, int>> child_parent_ids{};
+    for (const auto &edge : edges)
+    {
+        int parent_id{std::get<0>(edge)};
+        ++this->edge_offsets.at(parent_id + 1);
+        this->edge_ids.push_back(std::get<2>(edge));
+        for (int child_id : std::get<1>(edge))
+        {
+            this->child_ids.push_back(child_id);
+            child_parent_ids.push_back(std::make_pair(child_id, parent_id));
+        }
+        this->child_offsets.push_back(this->child_ids.size());
+    }
+    for (std::size_t id{0}; id < this->nodes.size(); ++id)
+        this->edge_offsets.at(id + 1) += this->edge_offsets.at(id);
+
+    std::sort(child_parent_ids.begin(), child_parent_ids.end());
+    child_parent_ids.erase(std::unique(child_parent_ids.begin(), child_parent_ids.end()), child_parent_ids.end());
+    this->parent_ids.reserve(child_parent_ids.size());
+    for (const auto &child_parent_id : child_parent_ids)
+    {
+        ++this->parent_offsets.at(child_parent_id.first + 1);
+        this->parent_ids.push_back(child_parent_id.second);
+    }
+    for (std::size_t id{0}; id < this->nodes.size(); ++id)
+        this->parent_offsets.at(id + 1) += this->parent_offsets.at(id);
+}
+
+template <typename T>
+std::size_t FrozenAndOrGraph<T>::get_num_nodes() const
+{
+    return this->nodes.size();
+}
+
+template <typename T>
+std::size_t FrozenAndOrGraph<T>::get_num_edges() const
+{
+    return this->edge_ids.size();
+}
+
+template <typename T>
+bool FrozenAndOrGraph<T>::get_id(const T &data, int &out) const
+{
+    auto range = this->node_index.equal_range(std::hash<T>{}(data));
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (this->nodes.at(it->second) == data)
+        {
+            out = it->second;
+            return true;
+        }
+    }
+
+    out = this->nodes.size();
+    return false;
+}
+
+template <typename T>
+const T &FrozenAndOrGraph<T>::get_node(int node_id) const
+{
+    return this->nodes.at(node_id);
+}
+
+template <typename T>
+std::pair<std::size_t, std::size_t> FrozenAndOrGraph<T>::get_edge_range(int node_id) const
+{
+    return std::make_pair(this->edge_offsets.at(node_id), this->edge_offsets.at(node_id + 1));
+}
+
+template <typename T>
+int FrozenAndOrGraph<T>::get_edge_id(std::size_t edge) const
+{
+    return this->edge_ids.at(edge);
+}
+
+template <typename T>
+IdRange FrozenAndOrGraph<T>::get_child_ids(std::size_t edge) const
+{
+    return IdRange{this->child_ids.data() + this->child_offsets.at(edge), this->child_ids.data() + this->child_offsets.at(edge + 1)};
+}
+
+template <typename T>
+IdRange FrozenAndOrGraph<T>::get_parent_ids(int node_id) const
+{
+    return IdRange{this->parent_ids.data() + this->parent_offsets.at(node_id), this->parent_ids.data() + this->parent_offsets.at(node_id + 1)};
+}
+
+template <typename T>
+const std::vector<T> &FrozenAndOrGraph<T>::get_nodes() const
+{
+    return this->nodes;
+}
+
+template <typename T>
+std::vector<std::tuple<T, std::vector<T>, int>> FrozenAndOrGraph<T>::get_edges() const
+{
+    std::vector<std::tuple<T, std::vector<T>, int>> edges_data{};
+    edges_data.reserve(this->get_num_edges());
+    for (std::size_t parent_id{0}; parent_id < this->nodes.size(); ++parent_id)
+    {
+        for (std::size_t e{this->edge_offsets.at(parent_id)}; e < this->edge_offsets.at(parent_id + 1); ++e)
+        {
+            std::vector<T> child_data{};
+            for (int child_id : this->get_child_ids(e))
+                child_data.push_back(this->nodes.at(child_id));
+            edges_data.push_back(std::make_tuple(this->nodes.at(parent_id), child_data, this->edge_ids.at(e)));
+        }
+    }
+    return edges_data;
+}
+
+template <typename T>
+std::vector<std::vector<T>> FrozenAndOrGraph<T>::get_successors(const T &data) const
+{
+    std::vector<std::vector<T>> successors{};
+
+    int data_id{};
+    if (this->get_id(data, data_id))
+    {
+        for (std::size_t e{this->edge_offsets.at(data_id)}; e < this->edge_offsets.at(data_id + 1); ++e)
+        {
+            std::vector<T> child_data{};
+            for (int child_id : this->get_child_ids(e))
+                child_data.push_back(this->nodes.at(child_id));
+            successors.push_back(child_data);
+        }
+    }
+
+    return successors;
+}
+
+template <typename T>
+std::vector<T> FrozenAndOrGraph<T>::get_predecessors(const T &data) const
+{
+    std::vector<T> predecessors{};
+
+    int data_id{};
+    if (this->get_id(data, data_id))
+    {
+        for (int parent_id : this->get_parent_ids(data_id))
+            predecessors.push_back(this->nodes.at(parent_id));
+    }
+
+    return predecessors;
+}
+
+template <typename T>
+std::vector<T> FrozenAndOrGraph<T>::get_root_nodes() const
+{
+    std::vector<T> root_nodes{};
+    for (std::size_t id{0}; id < this->nodes.size(); ++id)
+    {
+        if (this->parent_offsets.at(id) == this->parent_offsets.at(id + 1))
+            root_nodes.push_back(this->nodes.at(id));
+    }
+    return root_nodes;
+}
+
+template <typename T>
+std::vector<T> FrozenAndOrGraph<T>::get_leaf_nodes() const
+{
+    std::vector<T> leaf_nodes{};
+    for (std::size_t id{0}; id < this->nodes.size(); ++id)
+    {
+        if (this->edge_offsets.at(id) == this->edge_offsets.at(id + 1))
+            leaf_nodes.push_back(this->nodes.at(id));
+    }
+    return leaf_nodes;
+}
@@ -0,0 +1,66 @@
+#ifndef FROZEN_DIGRAPH_HPP
+#define FROZEN_DIGRAPH_HPP
+
+#include <cstddef>       // std::size_t
+#include <tuple>         // std::tuple
+#include <unordered_map> // std::unordered_multimap
+#include <utility>       // std::pair
+#include <vector>        // std::vector
+
+#include <graph/IdRange.hpp>
+
+// Immutable compressed-sparse-row snapshot of a DiGraph, created by DiGraph::freeze(). Node ids are dense and equal
+// to the ids of the source graph. The out-edges of node i are stored at [out_offsets[i], out_offsets[i + 1]) of the
+// target and attribute id arrays, in insertion order; in-edges are stored the same way.
+template <typename N, typename E = int>
+class FrozenDiGraph
+{
+private:
+    std::vector<N> nodes;      // indexed by node id
+    std::vector<E> edge_attrs; // distinct edge attributes, indexed by edge attribute id
+    std::unordered_multimap<std::size_t, int> node_index; // hash of the node -> ids sharing that hash
+
+    std::vector<std::size_t> out_offsets;
+    std::vector<int> out_targets;
+    std::vector<int> out_attr_ids;
+    std::vector<std::size_t> edge_positions; // position of every edge in the out-edge arrays, in insertion order
+
+    std::vector<std::size_t> in_offsets;
+    std::vector<int> in_sources;
+    std::vector<int> in_attr_ids;
+
+public:
+    FrozenDiGraph();
+    explicit FrozenDiGraph(const std::vector<N> &nodes, const std::vector<E> &edge_attrs, const std::vector<std::tuple<int, int, int>> &edges);
+    ~FrozenDiGraph() = default;
+
+    std::size_t get_num_nodes() const;
+    std::size_t get_num_edges() const;
+
+    // id based access
+    bool get_id(const N &node, int &out) const;
+    const N &get_node(int node_id) const;
+    const E &get_edge_attr(int edge_attr_id) const;
+
+    IdRange get_successor_ids(int node_id) const;
+    IdRange get_successor_attr_ids(int node_id) const; // parallel to get_successor_ids
+    IdRange get_predecessor_ids(int node_id) const;
+    IdRange get_predecessor_attr_ids(int node_id) const; // parallel to get_predecessor_ids
+
+    // value based access, same semantics and order as DiGraph
+    const std::vector<N> &get_nodes() const;
+    std::vector<std::pair<N, N>> get_edges() const;
+
+    std::vector<N> get_successors(const N &node) const;
+    std::vector<N> get_predecessors(const N &node) const;
+
+    std::vector<N> get_root_nodes() const;
+    std::vector<N> get_leaf_nodes() const;
+
+    E get_edge_attr(const std::pair<N, N> &edge) const;
+    const std::vector<E> &get_edge_attrs() const;
+};
+
+#include <graph/FrozenDiGraph.tpp>
+
+#endif // FROZEN_DIGRAPH_HPP
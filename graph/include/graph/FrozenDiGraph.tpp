@@ -0,0 +1,232 @@
+#include <algorithm>     // std::sort
+#include <cstddef>       // std::size_t
+#include <functional>    // std::hash
+#include <tuple>         // std::get, std::tuple
+#include <unordered_map> // std::unordered_multimap
+#include <utility>       // std::make_pair, std::pair
+#include <vector>        // std::vector
+
+#include <graph/IdRange.hpp>
+
+template <typename N, typename E>
+FrozenDiGraph<N, E>::FrozenDiGraph()
+    : nodes{}, edge_attrs{}, node_index{},
+      out_offsets{0}, out_targets{}, out_attr_ids{}, edge_positions{}, in_offsets{0}, in_sources{}, in_attr_ids{}
+{
+}
+
+template <typename N, typename E>
+FrozenDiGraph<N, E>::FrozenDiGraph(const std::vector<N> &nodes, const std::vector<E> &edge_attrs, const std::vector<std::tuple<int, int, int>> &edges)
+    : nodes{nodes}, edge_attrs{edge_attrs}, node_index{},
+      out_offsets(nodes.size() + 1, 0), out_targets(edges.size()), out_attr_ids(edges.size()), edge_positions{},
+      in_offsets(nodes.size() + 1, 0), in_sources(edges.size()), in_attr_ids(edges.size())
+{
+    this->node_index.reserve(this->nodes.size());
+    this->edge_positions.reserve(edges.size());
+    for (std::size_t id{0}; id < this->nodes.size(); ++id)
+        this->node_index.emplace(std::make_pair(std::hash<N>{}(this->nodes.at(id)), static_cast<int>(id)));
+
+    // counting sort of the (source, target, attribute id) triplets by source, keeping the order of every source
+    for (const auto &edge : edges)
+    {
+        ++this->out_offsets.at(std::get<0>(edge) + 1);
+        ++this->in_offsets.at(std::get<1>(edge) + 1);
+    }
+    for (std::size_t id{0}; id < this->nodes.size(); ++id)
+    {
+        this->out_offsets.at(id + 1) += this->out_offsets.at(id);
+        this->in_offsets.at(id + 1) += this->in_offsets.at(id);
+    }
+
+    std::vector<std::size_t> positions(this->out_offsets.begin(), this->out_offsets.end() - 1);
+    for (const auto &edge : edges)
+    {
+        std::size_t position{positions.at(std::get<0>(edge))++};
+        this->out_targets.at(position) = std::get<1>(edge);
+        this->out_attr_ids.at(position) = std::get<2>(edge);
+        this->edge_positions.push_back(position);
+    }
+
+    // the same for the in-edges, keeping the order of every target
+    positions.assign(this->in_offsets.begin(), this->in_offsets.end() - 1);
+    for (const auto &edge : edges)
+    {
+        std::size_t position{positions.at(std::get<1>(edge))++};
+        this->in_sources.at(position) = std::get<0>(edge);
+        this->in_attr_ids.at(position) = std::get<2>(edge);
+    }
+}
+
+template <typename N, typename E>
+std::size_t FrozenDiGraph<N, E>::get_num_nodes() const
+{
+    return this->nodes.size();
+}
+
+template <typename N, typename E>
+std::size_t FrozenDiGraph<N, E>::get_num_edges() const
+{
+    return this->out_targets.size();
+}
+
+template <typename N, typename E>
+bool FrozenDiGraph<N, E>::get_id(const N &node, int &out) const
+{
+    auto range = this->node_index.equal_range(std::hash<N>{}(node));
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (this->nodes.at(it->second) == node)
+        {
+            out = it->second;
+            return true;
+        }
+    }
+
+    out = this->nodes.size();
+    return false;
+}
+
+template <typename N, typename E>
+const N &FrozenDiGraph<N, E>::get_node(int node_id) const
+{
+    return this->nodes.at(node_id);
+}
+
+template <typename N, typename E>
+const E &FrozenDiGraph<N, E>::get_edge_attr(int edge_attr_id) const
+{
+    return this->edge_attrs.at(edge_attr_id);
+}
+
+template <typename N, typename E>
+IdRange FrozenDiGraph<N, E>::get_successor_ids(int node_id) const
+{
+    return IdRange{this->out_targets.data() + this->out_offsets.at(node_id), this->out_targets.data() + this->out_offsets.at(node_id + 1)};
+}
+
+template <typename N, typename E>
+IdRange FrozenDiGraph<N, E>::get_successor_attr_ids(int node_id) const
+{
+    return IdRange{this->out_attr_ids.data() + this->out_offsets.at(node_id), this->out_attr_ids.data() + this->out_offsets.at(node_id + 1)};
+}
+
+template <typename N, typename E>
+IdRange FrozenDiGraph<N, E>::get_predecessor_ids(int node_id) const
+{
+    return IdRange{this->in_sources.data() + this->in_offsets.at(node_id), this->in_sources.data() + this->in_offsets.at(node_id + 1)};
+}
+
+template <typename N, typename E>
+IdRange FrozenDiGraph<N, E>::get_predecessor_attr_ids(int node_id) const
+{
+    return IdRange{this->in_attr_ids.data() + this->in_offsets.at(node_id), this->in_attr_ids.data() + this->in_offsets.at(node_id + 1)};
+}
+
+template <typename N, typename E>
+const std::vector<N> &FrozenDiGraph<N, E>::get_nodes() const
+{
+    return this->nodes;
+}
+
+template <typename N, typename E>
+std::vector<std::pair<N, N>> FrozenDiGraph<N, E>::get_edges() const
+{
+    // sources are looked up by position, as the out-edge arrays only store the targets
+    std::vector<int> sources(this->get_num_edges());
+    for (std::size_t u{0}; u < this->nodes.size(); ++u)
+    {
+        for (std::size_t i{this->out_offsets.at(u)}; i < this->out_offsets.at(u + 1); ++i)
+            sources.at(i) = static_cast<int>(u);
+    }
+
+    std::vector<std::pair<N, N>> edges{};
+    edges.reserve(this->get_num_edges());
+    for (std::size_t position : this->edge_positions)
+        edges.push_back(std::make_pair(this->nodes.at(sources.at(position)), this->nodes.at(this->out_targets.at(position))));
+    return edges;
+}
+
+template <typename N, typename E>
+std::vector<N> FrozenDiGraph<N, E>::get_successors(const N &node) const
+{
+    std::vector<N> successors{};
+
+    int node_id{};
+    if (this->get_id(node, node_id))
+    {
+        for (int successor_id : this->get_successor_ids(node_id))
+            successors.push_back(this->nodes.at(successor_id));
+    }
+
+    return successors;
+}
+
+template <typename N, typename E>
+std::vector<N> FrozenDiGraph<N, E>::get_predecessors(const N &node) const
+{
+    std::vector<N> predecessors{};
+
+    int node_id{};
+    if (this->get_id(node, node_id))
+    {
+        // in order of node ids, as DiGraph::get_predecessors
+        IdRange in_edge_sources{this->get_predecessor_ids(node_id)};
+        std::vector<int> predecessor_ids(in_edge_sources.begin(), in_edge_sources.end());
+        std::sort(predecessor_ids.begin(), predecessor_ids.end());
+        for (int predecessor_id : predecessor_ids)
+            predecessors.push_back(this->nodes.at(predecessor_id));
+    }
+
+    return predecessors;
+}
+
+template <typename N, typename E>
+std::vector<N> FrozenDiGraph<N, E>::get_root_nodes() const
+{
+    std::vector<N> root_nodes{};
+    for (std::size_t id{0}; id < this->nodes.size(); ++id)
+    {
+        if (this->in_offsets.at(id) == this->in_offsets.at(id + 1))
+            root_nodes.push_back(this->nodes.at(id));
+    }
+    return root_nodes;
+}
+
+template <typename N, typename E>
+std::vector<N> FrozenDiGraph<N, E>::get_leaf_nodes() const
+{
+    std::vector<N> leaf_nodes{};
+    for (std::size_t id{0}; id < this->nodes.size(); ++id)
+    {
+        if (this->out_offsets.at(id) == this->out_offsets.at(id + 1))
+            leaf_nodes.push_back(this->nodes.at(id));
+    }
+    return leaf_nodes;
+}
+
+template <typename N, typename E>
+E FrozenDiGraph<N, E>::get_edge_attr(const std::pair<N, N> &edge) const
+{
+    E edge_attr{};
+    int u_id{};
+    int v_id{};
+    if (this->get_id(edge.first, u_id) && this->get_id(edge.second, v_id))
+    {
+        IdRange successor_ids{this->get_successor_ids(u_id)};
+        for (std::size_t i{0}; i < successor_ids.size(); ++i)
+        {
+            if (successor_ids[i] == v_id)
+            {
+                edge_attr = this->edge_attrs.at(this->get_successor_attr_ids(u_id)[i]);
+                break;
+            }
+        }
+    }
+    return edge_attr;
+}
+
+template <typename N, typename E>
+const std::vector<E> &FrozenDiGraph<N, E>::get_edge_attrs() const
+{
+    return this->edge_attrs;
+}
@@ -1,13 +1,16 @@
 #ifndef GRAPH_HPP
 #define GRAPH_HPP
 
-#include <map>     // std::map
-#include <sstream> // std::stringstream
-#include <string>  // std::string
-#include <utility> // std::pair
-#include <vector>  // std::vector
-
+#include <cstddef>       // std::size_t
+#include <ostream>       // std::ostream
+#include <string>        // std::string
+#include <unordered_map> // std::unordered_multimap
+#include <utility>       // std::pair
+#include <vector>        // std::vector
+
+#include <plot/DotOptions.hpp>
 #include <plot/I_Plotable.hpp>
+#include <plot/PlotService.hpp>
 
 template <typename T>
 class Graph : public I_Plotable
@@ -16,11 +19,10 @@ private:
     static constexpr char def_name[] = "undirectional_graph";
     std::string name;
 
-    std::map<int, std::vector<int>> adjacency_list;
-    std::map<int, T> node_ids;
-
-    std::vector<T> nodes;
-    std::vector<std::pair<T, T>> edges;
+    std::vector<T> nodes;                   // indexed by node id
+    std::vector<std::pair<int, int>> edges; // node ids of every edge, in insertion order
+    std::vector<std::vector<int>> adjacency_list;
+    std::unordered_multimap<std::size_t, int> node_index; // hash of the node -> ids sharing that hash
 
     bool get_id(const T &node, int &out) const;
 
@@ -31,7 +33,7 @@ public:
     explicit Graph(const std::vector<std::pair<T, T>> &edges, const std::string &name = def_name);
     ~Graph() = default;
 
-    std::vector<T> get_nodes() const;
+    const std::vector<T> &get_nodes() const;
     std::vector<std::pair<T, T>> get_edges() const;
 
     std::vector<T> get_neighbors(const T &node) const;
@@ -42,8 +44,8 @@ public:
     std::string get_name() const override;
     void set_name(const std::string &name);
 
-    std::stringstream generate_dot() const override;
-    void plot(const std::string &output_loc) const;
+    void write_dot(std::ostream &os, const DotOptions &options) const override;
+    void plot(PlotService &plot_service, const std::string &output_loc, PlotFormat format = PlotFormat::png, const DotOptions &options = DotOptions{}) const;
 };
 
 #include <graph/Graph.tpp>
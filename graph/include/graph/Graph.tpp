@@ -1,19 +1,21 @@
-#include <algorithm>     // std::find, std::find_if, std::for_each
-#include <map>           // std::map
-#include <memory>        // std::make_shared, std::shared_ptr
-#include <sstream>       // std::stringstream
+#include <algorithm>     // std::find, std::for_each
+#include <cstddef>       // std::size_t
+#include <functional>    // std::hash
+#include <ostream>       // std::ostream
 #include <string>        // std::string
+#include <unordered_map> // std::unordered_multimap
 #include <utility>       // std::make_pair, std::pair
 #include <vector>        // std::vector
 
+#include <plot/DotOptions.hpp>
 #include <plot/I_Plotable.hpp>
-#include <plot/Plotter.hpp>
+#include <plot/PlotService.hpp>
 
 #include <utils/utils.hpp> // std::to_snake_case
 
 template <typename T>
 Graph<T>::Graph(const std::string &name)
-    : name{name}, adjacency_list{}, node_ids{}, nodes{}, edges{}
+    : name{name}, nodes{}, edges{}, adjacency_list{}, node_index{}
 {
 }
 
@@ -27,21 +29,18 @@ Graph<T>::Graph(const std::vector<std::pair<T, T>> &edges, const std::string &na
 template <typename T>
 bool Graph<T>::get_id(const T &node, int &out) const
 {
-    auto it = std::find_if(this->node_ids.begin(), this->node_ids.end(),
-                           [&node](const auto &m) {
-                               return (m.second == node);
-                           });
-
-    if (it != node_ids.end())
-    {
-        out = it->first;
-        return true;
-    }
-    else
+    auto range = this->node_index.equal_range(std::hash<T>{}(node));
+    for (auto it = range.first; it != range.second; ++it)
     {
-        out = this->node_ids.size();
-        return false;
+        if (this->nodes.at(it->second) == node)
+        {
+            out = it->second;
+            return true;
+        }
     }
+
+    out = this->nodes.size();
+    return false;
 }
 
 template <typename T>
@@ -49,15 +48,14 @@ void Graph<T>::add_node(const T &node, int &out_id)
 {
     if (!this->get_id(node, out_id))
     {
-        this->node_ids.emplace(std::make_pair(out_id, node));
-        this->adjacency_list.emplace(std::make_pair(out_id, std::vector<int>{}));
-
         this->nodes.push_back(node);
+        this->node_index.emplace(std::make_pair(std::hash<T>{}(node), out_id));
+        this->adjacency_list.push_back(std::vector<int>{});
     }
 }
 
 template <typename T>
-std::vector<T> Graph<T>::get_nodes() const
+const std::vector<T> &Graph<T>::get_nodes() const
 {
     return this->nodes;
 }
@@ -65,7 +63,11 @@ std::vector<T> Graph<T>::get_nodes() const
 template <typename T>
 std::vector<std::pair<T, T>> Graph<T>::get_edges() const
 {
-    return this->edges;
+    std::vector<std::pair<T, T>> edges_data{};
+    edges_data.reserve(this->edges.size());
+    for (const auto &edge : this->edges)
+        edges_data.push_back(std::make_pair(this->nodes.at(edge.first), this->nodes.at(edge.second)));
+    return edges_data;
 }
 
 template <typename T>
@@ -77,11 +79,7 @@ std::vector<T> Graph<T>::get_neighbors(const T &node) const
     if (this->get_id(node, node_id))
     {
         for (int neighbor_id : this->adjacency_list.at(node_id))
-        {
-            auto it = node_ids.find(neighbor_id);
-            if (it != node_ids.end())
-                neighbors.push_back(it->second);
-        }
+            neighbors.push_back(this->nodes.at(neighbor_id));
     }
 
     return neighbors;
@@ -96,16 +94,16 @@ void Graph<T>::add_edge(const T &u, const T &v)
     int v_id{};
     this->add_node(v, v_id);
 
-    auto u_it = this->adjacency_list.find(u_id);
-    if (std::find(u_it->second.begin(), u_it->second.end(), v_id) == u_it->second.end())
+    std::vector<int> &u_neighbors{this->adjacency_list.at(u_id)};
+    if (std::find(u_neighbors.begin(), u_neighbors.end(), v_id) == u_neighbors.end())
     {
-        u_it->second.push_back(v_id);
-        this->edges.push_back(std::make_pair(u, v));
+        u_neighbors.push_back(v_id);
+        this->edges.push_back(std::make_pair(u_id, v_id));
     }
 
-    auto v_it = this->adjacency_list.find(v_id);
-    if (std::find(v_it->second.begin(), v_it->second.end(), u_id) == v_it->second.end())
-        v_it->second.push_back(u_id);
+    std::vector<int> &v_neighbors{this->adjacency_list.at(v_id)};
+    if (std::find(v_neighbors.begin(), v_neighbors.end(), u_id) == v_neighbors.end())
+        v_neighbors.push_back(u_id);
 }
 
 template <typename T>
@@ -129,43 +127,54 @@ void Graph<T>::set_name(const std::string &name)
 }
 
 template <typename T>
-std::stringstream Graph<T>::generate_dot() const
+void Graph<T>::write_dot(std::ostream &os, const DotOptions &options) const
 {
-    std::stringstream ss_dot{};
-
-    ss_dot << "/*";
-    std::for_each(this->node_ids.begin(), this->node_ids.end(),
-                  [&ss_dot](const std::pair<int, T> &p) {
-                      ss_dot << '\n'
-                             << p.first << ":\n"
-                             << p.second << '\n';
-                  });
-    ss_dot << "*/\n";
-
-    ss_dot << '\n'
-           << "graph " << utils::to_snake_case(this->get_name())
-           << "{\n";
-    for (const std::pair<T, T> &edge : this->get_edges())
+    std::vector<bool> is_written{options.select_nodes(this->adjacency_list, std::vector<int>{})};
+
+    if (options.with_payloads)
     {
-        int u_id{};
-        int v_id{};
+        os << "/*";
+        for (size_t id{0}; id < this->nodes.size(); ++id)
+        {
+            if (!is_written.at(id))
+                continue;
 
-        this->get_id(edge.first, u_id);
-        this->get_id(edge.second, v_id);
+            os << '\n'
+               << id << ":\n"
+               << this->nodes.at(id) << '\n';
+        }
+        os << "*/\n";
+    }
 
-        ss_dot << u_id << " -- " << v_id
+    os << '\n'
+       << "graph " << utils::to_snake_case(this->get_name())
+       << "{\n";
+    std::vector<size_t> num_hidden_neighbors(this->nodes.size(), 0);
+    for (const std::pair<int, int> &edge : this->edges)
+    {
+        if (is_written.at(edge.first) && is_written.at(edge.second))
+        {
+            os << edge.first << " -- " << edge.second
                << '\n';
+        }
+        else if (is_written.at(edge.first))
+            ++num_hidden_neighbors.at(edge.first);
+        else if (is_written.at(edge.second))
+            ++num_hidden_neighbors.at(edge.second);
     }
-    ss_dot << "}\n";
+    for (size_t id{0}; id < this->nodes.size(); ++id)
+    {
+        if (num_hidden_neighbors.at(id) == 0)
+            continue;
 
-    return ss_dot;
+        os << "collapsed_" << id << " [label = \"" << num_hidden_neighbors.at(id) << " more\", shape = plaintext]\n"
+           << id << " -- collapsed_" << id << " [style = dashed]\n";
+    }
+    os << "}\n";
 }
 
 template <typename T>
-void Graph<T>::plot(const std::string &output_loc) const
+void Graph<T>::plot(PlotService &plot_service, const std::string &output_loc, PlotFormat format, const DotOptions &options) const
 {
-    std::shared_ptr<I_Plotable> graph_ptr = std::make_shared<Graph<T>>(*this);
-    Plotter plotter{graph_ptr, output_loc};
-    plotter.generate_dot();
-    plotter.render_dot();
-}
\ No newline at end of file
+    plot_service.submit(*this, output_loc, format, options);
+}
@@ -0,0 +1,47 @@
+#ifndef ID_RANGE_HPP
+#define ID_RANGE_HPP
+
+#include <cstddef> // std::size_t
+
+// Non-owning range over a contiguous block of node, edge or attribute ids of a frozen graph
+class IdRange
+{
+private:
+    const int *first;
+    const int *last;
+
+public:
+    IdRange(const int *first, const int *last)
+        : first{first}, last{last}
+    {
+    }
+
+    ~IdRange() = default;
+
+    const int *begin() const
+    {
+        return this->first;
+    }
+
+    const int *end() const
+    {
+        return this->last;
+    }
+
+    std::size_t size() const
+    {
+        return static_cast<std::size_t>(this->last - this->first);
+    }
+
+    bool empty() const
+    {
+        return (this->first == this->last);
+    }
+
+    int operator[](std::size_t i) const
+    {
+        return this->first[i];
+    }
+};
+
+#endif // ID_RANGE_HPP
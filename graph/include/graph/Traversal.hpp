@@ -0,0 +1,49 @@
+#ifndef TRAVERSAL_HPP
+#define TRAVERSAL_HPP
+
+#include <vector> // std::vector
+
+#include <graph/FrozenDiGraph.hpp>
+
+#include <utils/ThreadPool.hpp>
+
+// Level-synchronous traversals of frozen directional graphs (see DiGraph::freeze()), working on node ids. Every level
+// is expanded with ThreadPool::parallel_for: each frontier node writes to its own slot and the slots are merged in
+// frontier order, hence the results do not depend on the number of threads or on the thread scheduling.
+namespace traversal
+{
+    // Number of edges on a shortest path from any of the sources to every node, -1 for unreachable nodes. With
+    // 'reverse' set, edges are followed from target to source.
+    template <typename N, typename E>
+    std::vector<int> bfs_levels(const FrozenDiGraph<N, E> &graph, const std::vector<int> &source_ids, ThreadPool &thread_pool, bool reverse = false);
+
+    // Nodes reachable from any of the sources (sources included), indexed by node id
+    template <typename N, typename E>
+    std::vector<bool> get_reachable(const FrozenDiGraph<N, E> &graph, const std::vector<int> &source_ids, ThreadPool &thread_pool, bool reverse = false);
+
+    // Partition of the nodes into levels, such that every edge leads from a lower to a higher level; the nodes of a
+    // level are sorted by id. Returns false if the graph contains a cycle.
+    template <typename N, typename E>
+    bool topological_levels(const FrozenDiGraph<N, E> &graph, ThreadPool &thread_pool, std::vector<std::vector<int>> &out);
+
+    template <typename N, typename E>
+    bool topological_sort(const FrozenDiGraph<N, E> &graph, ThreadPool &thread_pool, std::vector<int> &out);
+
+    // Single or multi-source weighted paths on a directed acyclic graph, where 'weight' maps an edge attribute to
+    // the length of the edge. Unreachable nodes get a distance of +/-infinity and a predecessor of -1. Return false
+    // if the graph contains a cycle.
+    template <typename N, typename E, typename W>
+    bool dag_shortest_paths(const FrozenDiGraph<N, E> &graph, const std::vector<int> &source_ids, W &&weight, ThreadPool &thread_pool,
+                            std::vector<double> &out_distances, std::vector<int> &out_predecessor_ids);
+
+    template <typename N, typename E, typename W>
+    bool dag_longest_paths(const FrozenDiGraph<N, E> &graph, const std::vector<int> &source_ids, W &&weight, ThreadPool &thread_pool,
+                           std::vector<double> &out_distances, std::vector<int> &out_predecessor_ids);
+
+    // Node ids of the path ending in 'target_id', as recorded in the predecessor ids of one of the path routines
+    inline std::vector<int> get_path(const std::vector<int> &predecessor_ids, int target_id);
+} // namespace traversal
+
+#include <graph/Traversal.tpp>
+
+#endif // TRAVERSAL_HPP
@@ -0,0 +1,207 @@
+#include <algorithm> // std::reverse, std::sort
+#include <atomic>    // std::atomic
+#include <cstddef>   // std::size_t
+#include <limits>    // std::numeric_limits
+#include <utility>   // std::move
+#include <vector>    // std::vector
+
+#include <graph/FrozenDiGraph.hpp>
+#include <graph/IdRange.hpp>
+
+#include <utils/ThreadPool.hpp>
+
+template <typename N, typename E>
+std::vector<int> traversal::bfs_levels(const FrozenDiGraph<N, E> &graph, const std::vector<int> &source_ids, ThreadPool &thread_pool, bool reverse)
+{
+    std::vector<int> levels(graph.get_num_nodes(), -1);
+
+    std::vector<int> frontier{};
+    for (int source_id : source_ids)
+    {
+        if (levels.at(source_id) == -1)
+        {
+            levels.at(source_id) = 0;
+            frontier.push_back(source_id);
+        }
+    }
+
+    // Levels are only read while a frontier is expanded and only written while the candidates are merged.
+    for (int level{1}; !frontier.empty(); ++level)
+    {
+        std::vector<std::vector<int>> candidates(frontier.size());
+        thread_pool.parallel_for(frontier.size(), [&graph, &frontier, &levels, &candidates, reverse](std::size_t i) {
+            IdRange neighbour_ids{reverse ? graph.get_predecessor_ids(frontier.at(i)) : graph.get_successor_ids(frontier.at(i))};
+            for (int neighbour_id : neighbour_ids)
+            {
+                if (levels.at(neighbour_id) == -1)
+                    candidates.at(i).push_back(neighbour_id);
+            }
+        });
+
+        std::vector<int> next_frontier{};
+        for (const auto &frontier_candidates : candidates)
+        {
+            for (int candidate_id : frontier_candidates)
+            {
+                if (levels.at(candidate_id) == -1)
+                {
+                    levels.at(candidate_id) = level;
+                    next_frontier.push_back(candidate_id);
+                }
+            }
+        }
+        frontier.swap(next_frontier);
+    }
+
+    return levels;
+}
+
+template <typename N, typename E>
+std::vector<bool> traversal::get_reachable(const FrozenDiGraph<N, E> &graph, const std::vector<int> &source_ids, ThreadPool &thread_pool, bool reverse)
+{
+    std::vector<int> levels{traversal::bfs_levels(graph, source_ids, thread_pool, reverse)};
+
+    std::vector<bool> is_reachable(levels.size(), false);
+    for (std::size_t id{0}; id < levels.size(); ++id)
+        is_reachable.at(id) = (levels.at(id) != -1);
+    return is_reachable;
+}
+
+template <typename N, typename E>
+bool traversal::topological_levels(const FrozenDiGraph<N, E> &graph, ThreadPool &thread_pool, std::vector<std::vector<int>> &out)
+{
+    out.clear();
+
+    // Kahn's algorithm: exactly one of the decrements brings the remaining in-degree of a node to zero
+    std::vector<std::atomic<int>> in_degrees(graph.get_num_nodes());
+    thread_pool.parallel_for(in_degrees.size(), [&graph, &in_degrees](std::size_t id) {
+        in_degrees.at(id).store(static_cast<int>(graph.get_predecessor_ids(id).size()));
+    });
+
+    std::vector<int> level{};
+    for (std::size_t id{0}; id < in_degrees.size(); ++id)
+    {
+        if (in_degrees.at(id).load() == 0)
+            level.push_back(id);
+    }
+
+    std::size_t num_sorted{0};
+    while (!level.empty())
+    {
+        std::vector<std::vector<int>> released(level.size());
+        thread_pool.parallel_for(level.size(), [&graph, &level, &in_degrees, &released](std::size_t i) {
+            for (int successor_id : graph.get_successor_ids(level.at(i)))
+            {
+                if (in_degrees.at(successor_id).fetch_sub(1) == 1)
+                    released.at(i).push_back(successor_id);
+            }
+        });
+
+        std::vector<int> next_level{};
+        for (const auto &level_released : released)
+            next_level.insert(next_level.end(), level_released.begin(), level_released.end());
+        std::sort(next_level.begin(), next_level.end());
+
+        num_sorted += level.size();
+        out.push_back(std::move(level));
+        level = std::move(next_level);
+    }
+
+    if (num_sorted != graph.get_num_nodes())
+    {
+        out.clear();
+        return false;
+    }
+    return true;
+}
+
+template <typename N, typename E>
+bool traversal::topological_sort(const FrozenDiGraph<N, E> &graph, ThreadPool &thread_pool, std::vector<int> &out)
+{
+    out.clear();
+
+    std::vector<std::vector<int>> levels{};
+    if (!traversal::topological_levels(graph, thread_pool, levels))
+        return false;
+
+    out.reserve(graph.get_num_nodes());
+    for (const auto &level : levels)
+        out.insert(out.end(), level.begin(), level.end());
+    return true;
+}
+
+namespace traversal
+{
+    // Relaxes the nodes level by level in topological order. Every node pulls from its predecessors, which all lie in
+    // earlier levels, so the nodes of a level are independent. Sources behave as if they were connected to a virtual
+    // root by edges of length zero. Ties go to the predecessor with the lowest id.
+    template <typename N, typename E, typename W, typename C>
+    bool dag_paths(const FrozenDiGraph<N, E> &graph, const std::vector<int> &source_ids, W &weight, C is_better, double unreachable, ThreadPool &thread_pool,
+                   std::vector<double> &out_distances, std::vector<int> &out_predecessor_ids)
+    {
+        out_distances.assign(graph.get_num_nodes(), unreachable);
+        out_predecessor_ids.assign(graph.get_num_nodes(), -1);
+
+        std::vector<std::vector<int>> levels{};
+        if (!traversal::topological_levels(graph, thread_pool, levels))
+            return false;
+
+        std::vector<bool> is_source(graph.get_num_nodes(), false);
+        for (int source_id : source_ids)
+            is_source.at(source_id) = true;
+
+        for (const auto &level : levels)
+        {
+            thread_pool.parallel_for(level.size(), [&graph, &weight, &is_better, unreachable, &level, &is_source, &out_distances, &out_predecessor_ids](std::size_t i) {
+                int node_id{level.at(i)};
+                double distance{is_source.at(node_id) ? 0.0 : unreachable};
+                int predecessor_id{-1};
+
+                IdRange predecessor_ids{graph.get_predecessor_ids(node_id)};
+                IdRange predecessor_attr_ids{graph.get_predecessor_attr_ids(node_id)};
+                for (std::size_t j{0}; j < predecessor_ids.size(); ++j)
+                {
+                    if (out_distances.at(predecessor_ids[j]) == unreachable)
+                        continue;
+
+                    double candidate{out_distances.at(predecessor_ids[j]) + weight(graph.get_edge_attr(predecessor_attr_ids[j]))};
+                    if (distance == unreachable || is_better(candidate, distance))
+                    {
+                        distance = candidate;
+                        predecessor_id = predecessor_ids[j];
+                    }
+                }
+
+                out_distances.at(node_id) = distance;
+                out_predecessor_ids.at(node_id) = predecessor_id;
+            });
+        }
+
+        return true;
+    }
+} // namespace traversal
+
+template <typename N, typename E, typename W>
+bool traversal::dag_shortest_paths(const FrozenDiGraph<N, E> &graph, const std::vector<int> &source_ids, W &&weight, ThreadPool &thread_pool,
+                                   std::vector<double> &out_distances, std::vector<int> &out_predecessor_ids)
+{
+    return traversal::dag_paths(graph, source_ids, weight, [](double lhs, double rhs) { return lhs < rhs; }, std::numeric_limits<double>::infinity(),
+                                thread_pool, out_distances, out_predecessor_ids);
+}
+
+template <typename N, typename E, typename W>
+bool traversal::dag_longest_paths(const FrozenDiGraph<N, E> &graph, const std::vector<int> &source_ids, W &&weight, ThreadPool &thread_pool,
+                                  std::vector<double> &out_distances, std::vector<int> &out_predecessor_ids)
+{
+    return traversal::dag_paths(graph, source_ids, weight, [](double lhs, double rhs) { return lhs > rhs; }, -std::numeric_limits<double>::infinity(),
+                                thread_pool, out_distances, out_predecessor_ids);
+}
+
+inline std::vector<int> traversal::get_path(const std::vector<int> &predecessor_ids, int target_id)
+{
+    std::vector<int> path{};
+    for (int node_id{target_id}; node_id != -1; node_id = predecessor_ids.at(node_id))
+        path.push_back(node_id);
+    std::reverse(path.begin(), path.end());
+    return path;
+}
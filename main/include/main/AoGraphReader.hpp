@@ -0,0 +1,89 @@
+#ifndef AO_GRAPH_READER_HPP
+#define AO_GRAPH_READER_HPP
+
+#include <cstddef>       // std::size_t
+#include <cstdint>       // std::int64_t, std::uint64_t
+#include <istream>       // std::istream
+#include <string>        // std::string
+#include <unordered_map> // std::unordered_map
+#include <vector>        // std::vector
+
+#include <nlohmann/json.hpp>
+
+struct AoGraphUnion
+{
+    std::string union_id;
+    std::string parent_component;
+    std::vector<std::string> child_components;
+    bool has_id;
+    int id;
+};
+
+// Plain description of the JSON layout of an AND-OR graph: component labels by id and unions sorted by id
+struct AoGraphDescription
+{
+    std::unordered_map<std::string, std::string> component_labels;
+    std::vector<AoGraphUnion> unions;
+};
+
+// SAX handler for nlohmann::json that reads the JSON layout of an AND-OR graph while streaming through the file,
+// instead of first parsing the whole file into a DOM. Unknown keys are skipped.
+class AoGraphReader
+{
+private:
+    struct Frame
+    {
+        bool is_array;
+        std::string key;
+    };
+
+    AoGraphDescription description;
+    std::unordered_map<std::string, std::size_t> union_positions;
+    std::vector<Frame> frames;
+    std::string error;
+
+    bool is_in(const char *section, const char *field) const;
+    bool set_union_id(std::int64_t id);
+
+public:
+    AoGraphReader();
+    ~AoGraphReader() = default;
+
+    static bool read(std::istream &is, AoGraphDescription &out, std::string &out_error);
+    static AoGraphDescription from_json(const nlohmann::json &json);
+
+    // nlohmann::json SAX interface
+    bool null();
+    bool boolean(bool value);
+    bool number_integer(std::int64_t value);
+    bool number_unsigned(std::uint64_t value);
+    bool number_float(double value, const std::string &text);
+    bool string(std::string &value);
+    template <typename B>
+    bool binary(B &value);
+
+    bool start_object(std::size_t num_elements);
+    bool key(std::string &value);
+    bool end_object();
+    bool start_array(std::size_t num_elements);
+    bool end_array();
+
+    template <typename Exception>
+    bool parse_error(std::size_t position, const std::string &last_token, const Exception &exception);
+};
+
+template <typename B>
+bool AoGraphReader::binary(B & /*value*/)
+{
+    return true;
+}
+
+template <typename Exception>
+bool AoGraphReader::parse_error(std::size_t /*position*/, const std::string & /*last_token*/,
+                                const Exception &exception)
+{
+    this->error = exception.what();
+    return false;
+}
+
+#endif // AO_GRAPH_READER_HPP
@@ -1,48 +1,128 @@
 #ifndef ASSEMBLY_HPP
 #define ASSEMBLY_HPP
 
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <set>
 #include <string>
+#include <tuple>
 #include <unordered_map>
+#include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include <graph/AndOrGraph.hpp>
 #include <graph/DiGraph.hpp>
 #include <graph/Graph.hpp>
 
+#include <main/AoGraphReader.hpp>
 #include <main/Component.hpp>
+#include <main/RuleIndex.hpp>
+
+#include <boost/dynamic_bitset.hpp>
 
 #include <nlohmann/json.hpp>
 
 using Subassembly = std::vector<Component>;
+using SubassemblyMask = boost::dynamic_bitset<>; // bit i is set if the i-th component (sorted by name) is part of the subassembly
+
+// Changes of the AND-OR graph caused by an incremental update of the assembly
+struct AoGraphDiff
+{
+    std::vector<Subassembly> added_nodes;
+    std::vector<Subassembly> removed_nodes;
+    std::vector<std::tuple<Subassembly, std::vector<Subassembly>, int>> added_edges;
+    std::vector<std::tuple<Subassembly, std::vector<Subassembly>, int>> removed_edges;
+};
 
 class Assembly
 {
 private:
+    static constexpr char snapshot_magic[4] = {'A', 'O', 'G', 'S'};
+    static constexpr std::uint32_t snapshot_version{3};
+
     std::vector<Component> components;
     std::vector<DiGraph<Component>> obstruction_graphs;
     Graph<Component> connection_graph;
     AndOrGraph<Subassembly> ao_graph;
+    size_t num_threads; // number of threads used to generate the AND-OR graph
 
     std::unordered_map<Component, std::vector<Subassembly>> blocking_rules;
     std::unordered_map<Component, std::vector<Subassembly>> technical_constraints;
 
-    std::unordered_map<Component, std::vector<Subassembly>> compute_blocking_rules() const;
-    bool check_tech_feasibility(const Subassembly &subassembly) const;
-    bool check_geom_feasibility(const Subassembly &subassembly) const;
-    bool validate_triplet(const std::vector<Subassembly> &triplet) const;
-    std::vector<Component> get_neighbors(const Subassembly &subassembly) const;
-    AndOrGraph<Subassembly> generate_ao_graph() const;
+    // Dense integer ids of the components, assigned in sorted order, used to encode subassemblies as bitsets
+    std::vector<Component> indexed_components;
+    std::unordered_map<Component, int> component_ids;
+    std::vector<std::vector<int>> component_neighbors;
+    RuleIndex feasibility_rules; // compiled blocking rules and technical constraints
+    std::vector<std::vector<int>> symmetry_orbits; // interchangeable components (sorted ids); subassemblies are generated in canonical form only
+
+    void index_components();
+    std::vector<Subassembly> compute_blocking_rules(const Component &component) const;
+    std::vector<SubassemblyMask> minimize_rules(std::vector<SubassemblyMask> rules) const;
+    void compile_feasibility_rules();
+    std::vector<std::pair<int, SubassemblyMask>> compile_rules(const std::unordered_map<Component, std::vector<Subassembly>> &rules) const;
+    SubassemblyMask to_mask(const Subassembly &subassembly) const;
+    Subassembly to_subassembly(const SubassemblyMask &mask) const;
+
+    void compute_symmetry_orbits();
+    bool is_interchangeable(int component_id1, int component_id2, const std::set<std::pair<int, SubassemblyMask>> &rules) const;
+    SubassemblyMask canonicalize(const SubassemblyMask &subassembly) const;
+    std::vector<int> get_canonical_permutation(const SubassemblyMask &subassembly) const;
+    SubassemblyMask permute(const SubassemblyMask &subassembly, const std::vector<int> &permutation) const;
+    std::vector<SubassemblyMask> reduce_symmetric(const std::vector<SubassemblyMask> &subassemblies) const;
+
+    bool check_feasibility(const SubassemblyMask &subassembly) const;
+    std::vector<int> get_neighbors(const SubassemblyMask &subassembly) const;
+    std::vector<std::pair<SubassemblyMask, SubassemblyMask>> enumerate_cutsets(const SubassemblyMask &subassembly, const std::unordered_map<SubassemblyMask, size_t> &subasm_index) const;
+
+    AoGraphDiff regenerate_ao_graph();
+    bool is_supported(const SubassemblyMask &subassembly, const std::unordered_set<SubassemblyMask> &prev_subassemblies) const;
+    AoGraphDiff update_ao_graph(const std::vector<Component> &prev_components, const std::vector<std::pair<int, SubassemblyMask>> &changed_rules);
+    AoGraphDiff update_blocking_rules(const Component &component);
+
+    std::uint64_t compute_content_hash() const;
+    std::string get_cache_file_path(const std::string &cache_dir) const;
+    bool load_cached_ao_graph(const std::string &cache_dir);
+    void store_cached_ao_graph(const std::string &cache_dir) const;
+    void write_snapshot(std::ostream &os) const;
+    bool read_snapshot(std::istream &is, std::vector<Component> &out_components, AndOrGraph<Subassembly> &out_ao_graph) const;
+    void build_ao_graph(const AoGraphDescription &description);
 
 public:
     Assembly();
-    explicit Assembly(const std::vector<DiGraph<Component>> &obstr_graphs, const Graph<Component> &connect_graph, const std::unordered_map<Component, std::vector<Subassembly>> &tech_constraints);
+    explicit Assembly(const std::vector<DiGraph<Component>> &obstr_graphs, const Graph<Component> &connect_graph, const std::unordered_map<Component, std::vector<Subassembly>> &tech_constraints,
+                      size_t num_threads = 1, const std::string &cache_dir = "");
     ~Assembly() = default;
 
-    std::vector<Component> get_components() const;
-    AndOrGraph<Subassembly> get_ao_graph() const;
+    const std::vector<Component> &get_components() const;
+    const AndOrGraph<Subassembly> &get_ao_graph() const;
+
+    // Phases of the construction, recomputed from the current rules without modifying the assembly, e.g. to time them
+    std::unordered_map<Component, std::vector<Subassembly>> compute_blocking_rules() const;
+    AndOrGraph<Subassembly> generate_ao_graph() const;
+
+    // With interchangeable components, the AND-OR graph only holds canonical subassemblies: parts of an orbit are
+    // replaced by its first parts. Edges whose two parts share a canonical form keep a single child.
+    bool has_symmetries() const;
+    Subassembly get_canonical_subassembly(const Subassembly &subassembly) const;
+    std::vector<Subassembly> get_canonical_partition(const std::vector<Subassembly> &subassemblies) const;
+    std::vector<std::vector<Subassembly>> get_successors(const Subassembly &subassembly, bool expand_symmetries = true) const;
+    AndOrGraph<Subassembly> get_expanded_ao_graph() const;
+
+    // Incremental updates: only the affected subassemblies and cutsets are revalidated, the changes are returned
+    AoGraphDiff add_technical_constraint(const Component &component, const Subassembly &subassembly);
+    AoGraphDiff remove_technical_constraint(const Component &component, const Subassembly &subassembly);
+    AoGraphDiff add_obstruction_edge(size_t direction, const Component &component, const Component &blocking_component);
+    AoGraphDiff remove_obstruction_edge(size_t direction, const Component &component, const Component &blocking_component);
+    AoGraphDiff add_component(const Component &component, const std::vector<Component> &neighbors);
 
     void import_ao_graph(const nlohmann::json &json);
     void import_ao_graph(const std::string &file_path);
+
+    void export_ao_graph_snapshot(const std::string &file_path) const;
+    bool import_ao_graph_snapshot(const std::string &file_path);
 };
 
 #endif // ASSEMBLY_HPP
\ No newline at end of file
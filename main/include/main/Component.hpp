@@ -1,10 +1,11 @@
 #ifndef COMPONENT_HPP
 #define COMPONENT_HPP
 
-#include <algorithm> // std::for_each
-#include <ostream>   // std::ostream
-#include <string>    // std::string
-#include <vector>    // std::vector
+#include <algorithm>  // std::for_each
+#include <functional> // std::hash
+#include <ostream>    // std::ostream
+#include <string>     // std::string
+#include <vector>     // std::vector
 
 #include <boost/functional/hash.hpp>
 
@@ -12,12 +13,14 @@ class Component
 {
 private:
     std::string name;
+    std::string equivalence_class; // components of the same class are interchangeable; empty if unique
 
 public:
-    Component(const std::string &name);
+    Component(const std::string &name, const std::string &equivalence_class = "");
     ~Component() = default;
 
     std::string get_name() const;
+    std::string get_equivalence_class() const;
 
     bool operator==(const Component &rhs) const;
     bool operator<(const Component &rhs) const;
@@ -26,6 +29,7 @@ public:
     friend std::ostream &operator<<(std::ostream &os, const std::vector<Component> &v_component);
     friend std::ostream &operator<<(std::ostream &os, const std::vector<std::vector<Component>> &vv_component);
     friend std::ostream &operator<<(std::ostream &os, const std::vector<std::vector<std::vector<Component>>> &vvv_component);
+    friend struct std::hash<Component>;
 };
 
 // Custom specialization of std::hash injected in namespace std to deal with key types: Component, std::vector<Component>, std::vector<std::vector<Component>>, std::vector<std::vector<std::vector<Component>>>.
@@ -37,7 +41,7 @@ namespace std
         std::size_t operator()(Component const &component) const noexcept
         {
             std::size_t seed{0};
-            boost::hash_combine(seed, boost::hash_value(component.get_name()));
+            boost::hash_combine(seed, boost::hash_value(component.name));
             return seed;
         }
     };
@@ -0,0 +1,44 @@
+#ifndef RULE_INDEX_HPP
+#define RULE_INDEX_HPP
+
+#include <cstddef> // std::size_t
+#include <utility> // std::pair
+#include <vector>  // std::vector
+
+#include <boost/dynamic_bitset.hpp>
+
+using SubassemblyMask = boost::dynamic_bitset<>;
+
+// Subset trie over feasibility rules of the form (component, rule): a subassembly violates a rule if it contains
+// every component of the rule, but not the component itself. Rules are stored as paths of increasing component ids,
+// so a query only descends into branches whose components are all part of the subassembly.
+class RuleIndex
+{
+private:
+    struct Node
+    {
+        std::vector<std::pair<int, int>> children; // (component id, node id), sorted by component id
+        std::vector<int> component_ids;            // components guarded by the rule ending in this node; -1 if not part of the assembly
+
+        Node();
+        ~Node() = default;
+    };
+
+    std::vector<Node> nodes;
+    std::size_t num_rules;
+
+    bool is_dominated(const SubassemblyMask &rule, int component_id, int node_id) const;
+    bool is_violated(const SubassemblyMask &subassembly, int node_id) const;
+
+public:
+    RuleIndex();
+    explicit RuleIndex(const std::vector<std::pair<int, SubassemblyMask>> &rules);
+    ~RuleIndex() = default;
+
+    std::size_t size() const;
+
+    bool add_rule(int component_id, const SubassemblyMask &rule);
+    bool is_satisfied(const SubassemblyMask &subassembly) const;
+};
+
+#endif // RULE_INDEX_HPP
@@ -0,0 +1,150 @@
+#include <algorithm> // std::sort
+#include <cstddef>   // std::size_t
+#include <cstdint>   // std::int64_t, std::uint64_t
+#include <istream>   // std::istream
+#include <string>    // std::string
+#include <vector>    // std::vector
+
+#include <main/AoGraphReader.hpp>
+
+#include <nlohmann/json.hpp>
+
+// JSON layout:
+// {
+//     "components": { "<component id>": { "label": "<name>", "parent_unions": [...] }, ... },
+//     "unions": { "<union id>": { "parent_component": "<component id>", "child_components": [...], "id": <int> }, ... }
+// }
+
+AoGraphReader::AoGraphReader()
+    : description{}, union_positions{}, frames{}, error{}
+{
+}
+
+bool AoGraphReader::read(std::istream &is, AoGraphDescription &out, std::string &out_error)
+{
+    AoGraphReader reader{};
+    if (!nlohmann::json::sax_parse(is, &reader))
+    {
+        out_error = reader.error;
+        return false;
+    }
+
+    std::sort(reader.description.unions.begin(), reader.description.unions.end(),
+              [](const AoGraphUnion &lhs, const AoGraphUnion &rhs) { return lhs.union_id < rhs.union_id; });
+    out = reader.description;
+    return true;
+}
+
+AoGraphDescription AoGraphReader::from_json(const nlohmann::json &json)
+{
+    AoGraphDescription description{};
+
+    for (const auto &component : json.at("components").items())
+        description.component_labels.emplace(component.key(), component.value().at("label").get<std::string>());
+
+    // iterating a JSON object visits its keys in sorted order
+    for (const auto &u : json.at("unions").items())
+    {
+        AoGraphUnion ao_union{u.key(), u.value().at("parent_component").get<std::string>(),
+                              u.value().at("child_components").get<std::vector<std::string>>(), false, -1};
+        if (u.value().contains("id"))
+        {
+            ao_union.has_id = true;
+            ao_union.id = u.value().at("id").get<int>();
+        }
+        description.unions.push_back(ao_union);
+    }
+
+    return description;
+}
+
+bool AoGraphReader::is_in(const char *section, const char *field) const
+{
+    // frames: root object > section object > entry object > field
+    return (this->frames.size() >= 3 && this->frames.at(0).key == section && this->frames.at(2).key == field);
+}
+
+bool AoGraphReader::set_union_id(std::int64_t id)
+{
+    if (this->frames.size() == 3 && this->is_in("unions", "id"))
+    {
+        AoGraphUnion &ao_union{this->description.unions.at(this->union_positions.at(this->frames.at(1).key))};
+        ao_union.has_id = true;
+        ao_union.id = static_cast<int>(id);
+    }
+    return true;
+}
+
+bool AoGraphReader::null()
+{
+    return true;
+}
+
+bool AoGraphReader::boolean(bool /*value*/)
+{
+    return true;
+}
+
+bool AoGraphReader::number_integer(std::int64_t value)
+{
+    return this->set_union_id(value);
+}
+
+bool AoGraphReader::number_unsigned(std::uint64_t value)
+{
+    return this->set_union_id(static_cast<std::int64_t>(value));
+}
+
+bool AoGraphReader::number_float(double /*value*/, const std::string & /*text*/)
+{
+    return true;
+}
+
+bool AoGraphReader::string(std::string &value)
+{
+    if (this->frames.size() == 3 && this->is_in("components", "label"))
+        this->description.component_labels[this->frames.at(1).key] = value;
+    else if (this->frames.size() == 3 && this->is_in("unions", "parent_component"))
+        this->description.unions.at(this->union_positions.at(this->frames.at(1).key)).parent_component = value;
+    else if (this->frames.size() == 4 && this->frames.at(3).is_array && this->is_in("unions", "child_components"))
+        this->description.unions.at(this->union_positions.at(this->frames.at(1).key)).child_components.push_back(value);
+    return true;
+}
+
+bool AoGraphReader::start_object(std::size_t /*num_elements*/)
+{
+    this->frames.push_back(Frame{false, ""});
+    return true;
+}
+
+bool AoGraphReader::key(std::string &value)
+{
+    this->frames.back().key = value;
+
+    // entering a new union
+    if (this->frames.size() == 2 && this->frames.at(0).key == "unions" &&
+        this->union_positions.find(value) == this->union_positions.end())
+    {
+        this->union_positions.emplace(value, this->description.unions.size());
+        this->description.unions.push_back(AoGraphUnion{value, "", {}, false, -1});
+    }
+    return true;
+}
+
+bool AoGraphReader::end_object()
+{
+    this->frames.pop_back();
+    return true;
+}
+
+bool AoGraphReader::start_array(std::size_t /*num_elements*/)
+{
+    this->frames.push_back(Frame{true, ""});
+    return true;
+}
+
+bool AoGraphReader::end_array()
+{
+    this->frames.pop_back();
+    return true;
+}
@@ -1,261 +1,1515 @@
-#include <algorithm>     // std::adjacent_find, std::copy, std::copy_if, std::find, std::includes, std::set_intersection, std::set_union, std::sort, std::transform, std::unique
-#include <cmath>         // std::ceil
-#include <fstream>       // std::ifstream
-#include <iostream>      // std::cout
+#include <algorithm>     // std::adjacent_find, std::all_of, std::any_of, std::copy_if, std::count_if, std::equal, std::fill, std::find_if, std::max, std::min, std::prev_permutation, std::sort, std::transform, std::unique
+#include <cstdint>       // std::int32_t, std::uint32_t, std::uint64_t
+#include <filesystem>    // std::filesystem::create_directories
+#include <fstream>       // std::ifstream, std::ofstream
+#include <iomanip>       // std::hex, std::setfill, std::setw
+#include <ios>           // std::ios_base
+#include <iostream>      // std::cerr, std::cout
+#include <istream>       // std::istream
 #include <iterator>      // std::back_inserter, std::inserter
 #include <map>           // std::map
+#include <ostream>       // std::ostream
 #include <set>           // std::set
+#include <sstream>       // std::ostringstream
 #include <string>        // std::string
-#include <tuple>         // std::get 
+#include <system_error>  // std::error_code
+#include <tuple>         // std::get, std::make_tuple, std::tuple
 #include <unordered_map> // std::unordered_map
-#include <utility>       // std::pair
+#include <unordered_set> // std::unordered_set
+#include <utility>       // std::make_pair, std::move, std::pair, std::swap
 #include <vector>        // std::vector
 
 #include <graph/AndOrGraph.hpp>
 #include <graph/DiGraph.hpp>
 #include <graph/Graph.hpp>
+#include <graph/IdRange.hpp>
 
+#include <main/AoGraphReader.hpp>
 #include <main/Assembly.hpp>
 #include <main/Component.hpp>
+#include <main/RuleIndex.hpp>
 
-#include <utils/utils.hpp> // utils::cartesian_product
+#include <utils/ThreadPool.hpp>
+#include <utils/utils.hpp> // utils::fnv1a_hash, utils::read_binary, utils::write_binary
+
+#include <boost/dynamic_bitset.hpp>
 
 #include <nlohmann/json.hpp>
 
 using Subassembly = std::vector<Component>;
 
 Assembly::Assembly()
-    : components{}, obstruction_graphs{}, connection_graph{}, ao_graph{},
-      blocking_rules{}, technical_constraints{}
+    : components{}, obstruction_graphs{}, connection_graph{}, ao_graph{}, num_threads{1},
+      blocking_rules{}, technical_constraints{},
+      indexed_components{}, component_ids{}, component_neighbors{}, feasibility_rules{}, symmetry_orbits{}
 {
 }
 
-Assembly::Assembly(const std::vector<DiGraph<Component>> &obstr_graphs, const Graph<Component> &connect_graph, const std::unordered_map<Component, std::vector<Subassembly>> &tech_constraints)
-    : components{}, obstruction_graphs{obstr_graphs}, connection_graph{connect_graph}, ao_graph{},
-      blocking_rules{}, technical_constraints{tech_constraints}
+Assembly::Assembly(const std::vector<DiGraph<Component>> &obstr_graphs, const Graph<Component> &connect_graph, const std::unordered_map<Component, std::vector<Subassembly>> &tech_constraints,
+                   size_t num_threads, const std::string &cache_dir)
+    : components{}, obstruction_graphs{obstr_graphs}, connection_graph{connect_graph}, ao_graph{}, num_threads{std::max<size_t>(num_threads, 1)},
+      blocking_rules{}, technical_constraints{tech_constraints},
+      indexed_components{}, component_ids{}, component_neighbors{}, feasibility_rules{}, symmetry_orbits{}
 {
     components = connection_graph.get_nodes();
+    this->index_components();
     blocking_rules = this->compute_blocking_rules();
-    ao_graph = this->generate_ao_graph();
+    this->compile_feasibility_rules();
+    this->compute_symmetry_orbits();
+
+    if (cache_dir.empty() || !this->load_cached_ao_graph(cache_dir))
+    {
+        ao_graph = this->generate_ao_graph();
+        if (!cache_dir.empty())
+            this->store_cached_ao_graph(cache_dir);
+    }
 }
 
 std::unordered_map<Component, std::vector<Subassembly>> Assembly::compute_blocking_rules() const
 {
-    std::unordered_map<Component, std::vector<Subassembly>> blocking_parts{};
+    std::unordered_map<Component, std::vector<Subassembly>> blocking_rules{};
     for (const auto &component : components)
-        blocking_parts.insert({component, std::vector<Subassembly>{}});
+        blocking_rules.insert({component, this->compute_blocking_rules(component)});
+
+    return blocking_rules;
+}
 
+std::vector<Subassembly> Assembly::compute_blocking_rules(const Component &component) const
+{
+    // A blocking rule picks one blocking part per obstruction graph. The rules are built one obstruction graph
+    // at a time and only the minimal ones are kept after every step: if a partial rule is a subset of another,
+    // all completions of the latter are supersets of completions of the former and would never block on their own.
+    std::vector<SubassemblyMask> partial_rules{SubassemblyMask(this->indexed_components.size())};
     for (const auto &obstr_graph : obstruction_graphs)
     {
-        for (const auto &component : components)
+        // blocking parts outside the assembly can never be part of a subassembly
+        std::vector<int> successor_ids{};
+        int node_id{};
+        if (obstr_graph.get_id(component, node_id))
         {
-            std::vector<Component> successors{obstr_graph.get_successors(component)};
-            std::sort(successors.begin(), successors.end());
-            blocking_parts.at(component).push_back(successors);
+            for (int successor_node_id : obstr_graph.get_successor_ids(node_id))
+            {
+                auto it = this->component_ids.find(obstr_graph.get_node(successor_node_id));
+                if (it != this->component_ids.end())
+                    successor_ids.push_back(it->second);
+            }
+        }
+
+        std::vector<SubassemblyMask> extended_rules{};
+        for (const auto &partial_rule : partial_rules)
+        {
+            // a partial rule that already contains one of the blocking parts dominates all other extensions
+            auto it = std::find_if(successor_ids.begin(), successor_ids.end(),
+                                   [&partial_rule](int successor_id) { return partial_rule.test(successor_id); });
+            if (it != successor_ids.end())
+            {
+                extended_rules.push_back(partial_rule);
+                continue;
+            }
+
+            for (int successor_id : successor_ids)
+            {
+                SubassemblyMask extended_rule{partial_rule};
+                extended_rule.set(successor_id);
+                extended_rules.push_back(extended_rule);
+            }
         }
+        partial_rules = this->minimize_rules(extended_rules);
+
+        if (partial_rules.empty())
+            break;
     }
 
-    std::unordered_map<Component, std::vector<Subassembly>> blocking_rules{};
-    for (const auto &component : components)
+    std::vector<Subassembly> rules{};
+    std::transform(partial_rules.begin(), partial_rules.end(), std::back_inserter(rules),
+                   [this](const SubassemblyMask &rule) { return this->to_subassembly(rule); });
+    std::sort(rules.begin(), rules.end());
+
+    return rules;
+}
+
+std::vector<SubassemblyMask> Assembly::minimize_rules(std::vector<SubassemblyMask> rules) const
+{
+    std::sort(rules.begin(), rules.end(),
+              [](const SubassemblyMask &lhs, const SubassemblyMask &rhs) { return lhs.count() < rhs.count(); });
+
+    std::vector<SubassemblyMask> minimal_rules{};
+    for (const auto &rule : rules)
+    {
+        bool is_dominated = std::any_of(minimal_rules.begin(), minimal_rules.end(),
+                                        [&rule](const SubassemblyMask &minimal_rule) { return minimal_rule.is_subset_of(rule); });
+        if (!is_dominated)
+            minimal_rules.push_back(rule);
+    }
+    return minimal_rules;
+}
+
+void Assembly::index_components()
+{
+    this->indexed_components = this->components;
+    std::sort(this->indexed_components.begin(), this->indexed_components.end());
+
+    this->component_ids.clear();
+    for (size_t id{0}; id < this->indexed_components.size(); ++id)
+        this->component_ids.emplace(this->indexed_components.at(id), static_cast<int>(id));
+
+    this->component_neighbors.clear();
+    for (const auto &component : this->indexed_components)
     {
-        std::vector<Subassembly> subassemblies{utils::cartesian_product(blocking_parts.at(component))};
-        for (auto &subassembly : subassemblies)
+        std::vector<int> neighbor_ids{};
+        for (const auto &neighbor : this->connection_graph.get_neighbors(component))
         {
-            std::sort(subassembly.begin(), subassembly.end());
-            subassembly.erase(std::unique(subassembly.begin(), subassembly.end()), subassembly.end());
+            auto it = this->component_ids.find(neighbor);
+            if (it != this->component_ids.end())
+                neighbor_ids.push_back(it->second);
         }
-        std::sort(subassemblies.begin(), subassemblies.end());
-        subassemblies.erase(std::unique(subassemblies.begin(), subassemblies.end()), subassemblies.end());
+        this->component_neighbors.push_back(neighbor_ids);
+    }
+}
 
-        blocking_rules.insert({component, subassemblies});
+void Assembly::compile_feasibility_rules()
+{
+    std::vector<std::pair<int, SubassemblyMask>> rules{this->compile_rules(this->blocking_rules)};
+    std::vector<std::pair<int, SubassemblyMask>> tech_rules{this->compile_rules(this->technical_constraints)};
+    rules.insert(rules.end(), tech_rules.begin(), tech_rules.end());
+    this->feasibility_rules = RuleIndex{rules};
+}
+
+std::vector<std::pair<int, SubassemblyMask>> Assembly::compile_rules(const std::unordered_map<Component, std::vector<Subassembly>> &rules) const
+{
+    std::vector<std::pair<int, SubassemblyMask>> rule_masks{};
+    for (auto it = rules.begin(); it != rules.end(); ++it)
+    {
+        // a component that is not part of the assembly can never be contained in a subassembly (id: -1)
+        auto id_it = this->component_ids.find(it->first);
+        int component_id{id_it != this->component_ids.end() ? id_it->second : -1};
+
+        for (const auto &rule : it->second)
+        {
+            // a rule containing an unknown component can never be a subset of a subassembly
+            bool is_known = std::all_of(rule.begin(), rule.end(), [this](const Component &component) {
+                return (this->component_ids.find(component) != this->component_ids.end());
+            });
+            if (is_known)
+                rule_masks.push_back(std::make_pair(component_id, this->to_mask(rule)));
+        }
     }
+    return rule_masks;
+}
 
-    return blocking_rules;
+SubassemblyMask Assembly::to_mask(const Subassembly &subassembly) const
+{
+    SubassemblyMask mask(this->indexed_components.size());
+    for (const auto &component : subassembly)
+        mask.set(this->component_ids.at(component));
+    return mask;
 }
 
-bool Assembly::check_tech_feasibility(const Subassembly &subassembly) const
+Subassembly Assembly::to_subassembly(const SubassemblyMask &mask) const
 {
-    for (auto it = technical_constraints.begin(); it != technical_constraints.end(); ++it)
+    // ids are assigned in sorted order, hence the resulting subassembly is sorted as well
+    Subassembly subassembly{};
+    for (size_t id{mask.find_first()}; id != SubassemblyMask::npos; id = mask.find_next(id))
+        subassembly.push_back(this->indexed_components.at(id));
+    return subassembly;
+}
+
+void Assembly::compute_symmetry_orbits()
+{
+    // Components of the same equivalence class are only interchangeable if swapping any two of them maps the
+    // connection graph and the compiled feasibility rules onto themselves. Interchangeability is transitive, as
+    // (a c) = (a b)(b c)(a b), so every class splits into orbits on which all permutations are automorphisms.
+    this->symmetry_orbits.clear();
+
+    std::map<std::string, std::vector<int>> class_members{};
+    for (size_t id{0}; id < this->indexed_components.size(); ++id)
     {
-        for (auto rule : it->second)
+        std::string equivalence_class{this->indexed_components.at(id).get_equivalence_class()};
+        if (!equivalence_class.empty())
+            class_members[equivalence_class].push_back(static_cast<int>(id));
+    }
+    if (class_members.empty())
+        return;
+
+    std::vector<std::pair<int, SubassemblyMask>> rule_list{this->compile_rules(this->blocking_rules)};
+    std::vector<std::pair<int, SubassemblyMask>> tech_rules{this->compile_rules(this->technical_constraints)};
+    rule_list.insert(rule_list.end(), tech_rules.begin(), tech_rules.end());
+    std::set<std::pair<int, SubassemblyMask>> rules{rule_list.begin(), rule_list.end()};
+
+    for (const auto &members : class_members)
+    {
+        std::vector<std::vector<int>> orbits{};
+        for (int component_id : members.second)
         {
-            // 'rule' needs to be sorted
-            std::sort(rule.begin(), rule.end());
-            bool is_subset = std::includes(subassembly.begin(), subassembly.end(), rule.begin(), rule.end());
-            if (is_subset && (std::find(subassembly.begin(), subassembly.end(), it->first) == subassembly.end()))
-                return false;
+            auto it = std::find_if(orbits.begin(), orbits.end(), [this, component_id, &rules](const std::vector<int> &orbit) {
+                return this->is_interchangeable(orbit.front(), component_id, rules);
+            });
+            if (it != orbits.end())
+                it->push_back(component_id);
+            else
+                orbits.push_back(std::vector<int>{component_id});
         }
+
+        if (orbits.size() > 1)
+            std::cerr << "[Symmetry reduction]: Components of equivalence class " << members.first
+                      << " aren't all interchangeable. Splitting it into " << orbits.size() << " orbits."
+                      << std::endl;
+
+        std::copy_if(orbits.begin(), orbits.end(), std::back_inserter(this->symmetry_orbits),
+                     [](const std::vector<int> &orbit) { return (orbit.size() > 1); });
     }
-    return true;
 }
 
-bool Assembly::check_geom_feasibility(const Subassembly &subassembly) const
+bool Assembly::is_interchangeable(int component_id1, int component_id2, const std::set<std::pair<int, SubassemblyMask>> &rules) const
 {
-    for (auto it = blocking_rules.begin(); it != blocking_rules.end(); ++it)
+    std::vector<int> permutation(this->indexed_components.size());
+    for (size_t id{0}; id < permutation.size(); ++id)
+        permutation.at(id) = static_cast<int>(id);
+    std::swap(permutation.at(component_id1), permutation.at(component_id2));
+
+    std::vector<int> neighbor_ids1{};
+    std::transform(this->component_neighbors.at(component_id1).begin(), this->component_neighbors.at(component_id1).end(),
+                   std::back_inserter(neighbor_ids1), [&permutation](int neighbor_id) { return permutation.at(neighbor_id); });
+    std::vector<int> neighbor_ids2{this->component_neighbors.at(component_id2)};
+    std::sort(neighbor_ids1.begin(), neighbor_ids1.end());
+    std::sort(neighbor_ids2.begin(), neighbor_ids2.end());
+    if (neighbor_ids1 != neighbor_ids2)
+        return false;
+
+    return std::all_of(rules.begin(), rules.end(), [this, &permutation, &rules](const std::pair<int, SubassemblyMask> &rule) {
+        int component_id{rule.first < 0 ? rule.first : permutation.at(rule.first)};
+        return (rules.find(std::make_pair(component_id, this->permute(rule.second, permutation))) != rules.end());
+    });
+}
+
+SubassemblyMask Assembly::canonicalize(const SubassemblyMask &subassembly) const
+{
+    // all permutations of an orbit are automorphisms, hence only the number of its components matters
+    SubassemblyMask canonical_subasm{subassembly};
+    for (const auto &orbit : this->symmetry_orbits)
     {
-        for (const auto &rule : it->second)
+        size_t count{0};
+        for (int component_id : orbit)
         {
-            // 'rule' needs to be sorted, but was already sorted when computing blocking rules
-            bool is_subset = std::includes(subassembly.begin(), subassembly.end(), rule.begin(), rule.end());
-            if (is_subset && (std::find(subassembly.begin(), subassembly.end(), it->first) == subassembly.end()))
-                return false;
+            count += canonical_subasm.test(component_id);
+            canonical_subasm.reset(component_id);
         }
+        for (size_t i{0}; i < count; ++i)
+            canonical_subasm.set(orbit.at(i));
     }
-    return true;
+    return canonical_subasm;
 }
 
-bool Assembly::validate_triplet(const std::vector<Subassembly> &triplet) const
+std::vector<int> Assembly::get_canonical_permutation(const SubassemblyMask &subassembly) const
 {
-    Subassembly subasm_union{};
-    std::set_union(triplet.at(0).begin(), triplet.at(0).end(),
-                   triplet.at(1).begin(), triplet.at(1).end(),
-                   std::back_inserter(subasm_union));
+    // maps the components of every orbit inside the subassembly onto the first components of the orbit, in order
+    std::vector<int> permutation(this->indexed_components.size());
+    for (size_t id{0}; id < permutation.size(); ++id)
+        permutation.at(id) = static_cast<int>(id);
 
-    Subassembly subasm_intersect{};
-    std::set_intersection(triplet.at(0).begin(), triplet.at(0).end(),
-                          triplet.at(1).begin(), triplet.at(1).end(),
-                          std::back_inserter(subasm_intersect));
+    for (const auto &orbit : this->symmetry_orbits)
+    {
+        std::vector<int> ordered_ids{};
+        std::copy_if(orbit.begin(), orbit.end(), std::back_inserter(ordered_ids), [&subassembly](int id) { return subassembly.test(id); });
+        std::copy_if(orbit.begin(), orbit.end(), std::back_inserter(ordered_ids), [&subassembly](int id) { return !subassembly.test(id); });
+        for (size_t i{0}; i < orbit.size(); ++i)
+            permutation.at(ordered_ids.at(i)) = orbit.at(i);
+    }
+    return permutation;
+}
 
-    return (subasm_union == triplet.at(2) && subasm_intersect.empty());
+SubassemblyMask Assembly::permute(const SubassemblyMask &subassembly, const std::vector<int> &permutation) const
+{
+    SubassemblyMask permuted_subasm(subassembly.size());
+    for (size_t id{subassembly.find_first()}; id != SubassemblyMask::npos; id = subassembly.find_next(id))
+        permuted_subasm.set(permutation.at(id));
+    return permuted_subasm;
 }
 
-std::vector<Component> Assembly::get_neighbors(const Subassembly &subassembly) const
+std::vector<SubassemblyMask> Assembly::reduce_symmetric(const std::vector<SubassemblyMask> &subassemblies) const
 {
-    std::vector<Component> asm_neighbors{};
-    for (const auto &component : subassembly)
+    if (this->symmetry_orbits.empty())
+        return subassemblies;
+
+    // keeps the first occurrence of every canonical form
+    std::vector<SubassemblyMask> canonical_subasms{};
+    std::unordered_set<SubassemblyMask> visited{};
+    for (const auto &subassembly : subassemblies)
     {
-        std::vector<Component> component_neighbors{connection_graph.get_neighbors(component)};
-        std::copy_if(component_neighbors.begin(), component_neighbors.end(), std::back_inserter(asm_neighbors),
-                     [&asm_neighbors, &subassembly](Component &component) {
-                         return (std::find(asm_neighbors.begin(), asm_neighbors.end(), component) == asm_neighbors.end()) &&
-                                (std::find(subassembly.begin(), subassembly.end(), component) == subassembly.end());
-                     });
+        SubassemblyMask canonical_subasm{this->canonicalize(subassembly)};
+        if (visited.insert(canonical_subasm).second)
+            canonical_subasms.push_back(canonical_subasm);
+    }
+    return canonical_subasms;
+}
+
+bool Assembly::check_feasibility(const SubassemblyMask &subassembly) const
+{
+    return this->feasibility_rules.is_satisfied(subassembly);
+}
+
+std::vector<int> Assembly::get_neighbors(const SubassemblyMask &subassembly) const
+{
+    SubassemblyMask visited{subassembly};
+    std::vector<int> asm_neighbors{};
+    for (size_t id{subassembly.find_first()}; id != SubassemblyMask::npos; id = subassembly.find_next(id))
+    {
+        for (int neighbor_id : component_neighbors.at(id))
+        {
+            if (!visited.test(neighbor_id))
+            {
+                visited.set(neighbor_id);
+                asm_neighbors.push_back(neighbor_id);
+            }
+        }
     }
     return asm_neighbors;
 }
 
+std::vector<std::pair<SubassemblyMask, SubassemblyMask>> Assembly::enumerate_cutsets(const SubassemblyMask &subassembly, const std::unordered_map<SubassemblyMask, size_t> &subasm_index) const
+{
+    // Every known subassembly of length k > 1 extends a known subassembly of length k - 1 with one neighbor.
+    // Hence, all known subassemblies inside 'subassembly' are found by growing them from single components
+    // along the connection graph, without ever leaving the set of known subassemblies.
+    // With symmetries, only canonical subassemblies are indexed and stand for all their symmetric images
+    auto find_subasm = [this, &subasm_index](const SubassemblyMask &subasm) {
+        return (this->symmetry_orbits.empty() ? subasm_index.find(subasm) : subasm_index.find(this->canonicalize(subasm)));
+    };
+
+    std::vector<SubassemblyMask> open_subasms{};
+    std::unordered_set<SubassemblyMask> visited{};
+    for (size_t id{subassembly.find_first()}; id != SubassemblyMask::npos; id = subassembly.find_next(id))
+    {
+        SubassemblyMask component(subassembly.size());
+        component.set(id);
+        if (find_subasm(component) != subasm_index.end() && visited.insert(component).second)
+            open_subasms.push_back(component);
+    }
+
+    size_t subasm_length{subassembly.count()};
+    std::vector<std::pair<SubassemblyMask, SubassemblyMask>> cutsets{};
+    while (!open_subasms.empty())
+    {
+        SubassemblyMask subasm1{open_subasms.back()};
+        open_subasms.pop_back();
+
+        // The complement has to be a known subassembly as well; each split is reported once, with the
+        // largest part first (ties are broken by the position of the parts in their length level, and
+        // by the parts themselves if both are symmetric images of the same subassembly).
+        SubassemblyMask subasm2{subassembly - subasm1};
+        auto it2 = find_subasm(subasm2);
+        if (it2 != subasm_index.end())
+        {
+            size_t subasm1_length{subasm1.count()};
+            size_t subasm1_index{find_subasm(subasm1)->second};
+            if (subasm1_length > subasm_length - subasm1_length ||
+                (subasm1_length == subasm_length - subasm1_length &&
+                 (subasm1_index < it2->second || (subasm1_index == it2->second && subasm1 < subasm2))))
+                cutsets.push_back(std::make_pair(subasm1, subasm2));
+        }
+
+        if (subasm1.count() + 1 >= subasm_length)
+            continue;
+
+        for (int neighbor_id : this->get_neighbors(subasm1))
+        {
+            if (!subassembly.test(neighbor_id))
+                continue;
+
+            SubassemblyMask candidate{subasm1};
+            candidate.set(neighbor_id);
+            if (find_subasm(candidate) != subasm_index.end() && visited.insert(candidate).second)
+                open_subasms.push_back(candidate);
+        }
+    }
+    return cutsets;
+}
+
 AndOrGraph<Subassembly> Assembly::generate_ao_graph() const
 {
     size_t num_components{components.size()};
-    std::map<size_t, std::vector<Subassembly>> subasm_length_map{};
+    std::map<size_t, std::vector<SubassemblyMask>> subasm_length_map{};
 
-    std::vector<Subassembly> one_component_asms{};
+    std::vector<SubassemblyMask> one_component_asms{};
     std::transform(components.begin(), components.end(), std::back_inserter(one_component_asms),
-                   [](const Component &component) { return Subassembly{component}; });
+                   [this](const Component &component) { return this->to_mask(Subassembly{component}); });
+    one_component_asms = this->reduce_symmetric(one_component_asms);
     subasm_length_map.insert({1, one_component_asms});
 
-    std::vector<Subassembly> connections{};
-    std::vector<std::pair<Component, Component>> pair_connections{connection_graph.get_edges()};
-    std::transform(pair_connections.begin(), pair_connections.end(), std::back_inserter(connections),
-                   [](const auto &connection) {
-                       return Subassembly{connection.first, connection.second};
-                   });
-
-    std::vector<Subassembly> two_component_asms{};
-    std::copy_if(connections.begin(), connections.end(), std::back_inserter(two_component_asms),
-                 [this](Subassembly &two_component_asm) {
-                     std::sort(two_component_asm.begin(), two_component_asm.end());
-                     return (this->check_geom_feasibility(two_component_asm) && this->check_tech_feasibility(two_component_asm));
-                 });
+    std::vector<SubassemblyMask> two_component_asms{};
+    for (const auto &connection : connection_graph.get_edges())
+    {
+        SubassemblyMask two_component_asm{this->to_mask(Subassembly{connection.first, connection.second})};
+        if (this->check_feasibility(two_component_asm))
+            two_component_asms.push_back(two_component_asm);
+    }
+    two_component_asms = this->reduce_symmetric(two_component_asms);
     subasm_length_map.insert({2, two_component_asms});
 
-    std::vector<Subassembly> complete_asm{components};
+    std::vector<SubassemblyMask> complete_asm{this->to_mask(components)};
     subasm_length_map.insert({num_components, complete_asm});
 
+    ThreadPool thread_pool{this->num_threads};
+
     for (size_t subasm_length{3}; subasm_length < num_components; ++subasm_length)
     {
-        std::vector<Subassembly> subassemblies{};
-        for (const auto &subassembly : subasm_length_map.at(subasm_length - 1))
+        const std::vector<SubassemblyMask> &prev_subassemblies{subasm_length_map.at(subasm_length - 1)};
+        std::vector<std::vector<SubassemblyMask>> extensions(prev_subassemblies.size());
+        thread_pool.parallel_for(prev_subassemblies.size(), [this, &prev_subassemblies, &extensions](size_t i) {
+            for (int neighbor_id : this->get_neighbors(prev_subassemblies.at(i)))
+            {
+                SubassemblyMask extension{prev_subassemblies.at(i)};
+                extension.set(neighbor_id);
+                extensions.at(i).push_back(this->symmetry_orbits.empty() ? extension : this->canonicalize(extension));
+            }
+        });
+
+        // merging in order of the extended subassemblies keeps the first occurrence of every candidate
+        std::vector<SubassemblyMask> candidates{};
+        std::unordered_set<SubassemblyMask> visited{};
+        for (const auto &subasm_extensions : extensions)
+        {
+            for (const auto &extension : subasm_extensions)
+            {
+                if (visited.insert(extension).second)
+                    candidates.push_back(extension);
+            }
+        }
+
+        std::vector<char> is_feasible(candidates.size());
+        thread_pool.parallel_for(candidates.size(), [this, &candidates, &is_feasible](size_t i) {
+            is_feasible.at(i) = this->check_feasibility(candidates.at(i));
+        });
+
+        std::vector<SubassemblyMask> subassemblies{};
+        for (size_t i{0}; i < candidates.size(); ++i)
         {
-            std::vector<Component> subasm_neighbors{this->get_neighbors(subassembly)};
-            std::vector<Subassembly> subassemblies_temp{
-                utils::cartesian_product(std::vector<Subassembly>{subassembly}, subasm_neighbors)};
-            std::copy_if(subassemblies_temp.begin(), subassemblies_temp.end(), std::back_inserter(subassemblies),
-                         [this, &subassemblies](auto &subassembly) {
-                             std::sort(subassembly.begin(), subassembly.end());
-                             return ((std::find(subassemblies.begin(), subassemblies.end(), subassembly) == subassemblies.end()) &&
-                                     this->check_geom_feasibility(subassembly) && this->check_tech_feasibility(subassembly));
-                         });
+            if (is_feasible.at(i))
+                subassemblies.push_back(candidates.at(i));
         }
         subasm_length_map.insert({subasm_length, subassemblies});
     }
 
-    std::vector<Subassembly> subassemblies{};
-    for (auto it = subasm_length_map.rbegin(); it != subasm_length_map.rend(); ++it)
-        subassemblies.insert(subassemblies.end(), it->second.begin(), it->second.end());
+    std::unordered_map<SubassemblyMask, size_t> subasm_index{};
+    for (const auto &length_subasms : subasm_length_map)
+    {
+        for (size_t i{0}; i < length_subasms.second.size(); ++i)
+            subasm_index.emplace(length_subasms.second.at(i), i);
+    }
 
-    std::vector<std::vector<Subassembly>> cutsets{};
+    // Cutsets are ordered by decreasing length of the parent and of its largest part, followed by the position
+    // of both parts in their length level.
+    std::vector<std::vector<SubassemblyMask>> cutsets{};
     for (size_t triplet3_len{num_components}; triplet3_len >= 3; --triplet3_len)
     {
-        for (size_t triplet1_len{triplet3_len - 1}; triplet1_len >= std::ceil(triplet3_len / 2.0); --triplet1_len)
+        const std::vector<SubassemblyMask> &parents{subasm_length_map.at(triplet3_len)};
+        std::vector<std::vector<std::pair<SubassemblyMask, SubassemblyMask>>> parent_cutsets(parents.size());
+        thread_pool.parallel_for(parents.size(), [this, &parents, &parent_cutsets, &subasm_index](size_t i) {
+            parent_cutsets.at(i) = this->enumerate_cutsets(parents.at(i), subasm_index);
+
+            // symmetric splits of a parent collapse into one edge between canonical subassemblies; if both parts
+            // share the same canonical form, the edge only keeps one child
+            if (!this->symmetry_orbits.empty())
+            {
+                for (auto &cutset : parent_cutsets.at(i))
+                    cutset = std::make_pair(this->canonicalize(cutset.first), this->canonicalize(cutset.second));
+            }
+        });
+
+        std::vector<std::pair<std::tuple<size_t, size_t, size_t>, std::vector<SubassemblyMask>>> length_cutsets{};
+        for (size_t i{0}; i < parents.size(); ++i)
         {
-            size_t triplet2_len{triplet3_len - triplet1_len};
-            std::vector<std::vector<Subassembly>> triplets{
-                utils::cartesian_product(std::vector<std::vector<Subassembly>>{subasm_length_map.at(triplet1_len),
-                                                                               subasm_length_map.at(triplet2_len),
-                                                                               subasm_length_map.at(triplet3_len)})};
-            std::copy_if(triplets.begin(), triplets.end(), std::back_inserter(cutsets),
-                         [this](auto &triplet) {
-                             std::sort(triplet.at(0).begin(), triplet.at(0).end());
-                             std::sort(triplet.at(1).begin(), triplet.at(1).end());
-                             std::sort(triplet.at(2).begin(), triplet.at(2).end());
-                             return this->validate_triplet(triplet);
-                         });
+            for (const auto &cutset : parent_cutsets.at(i))
+            {
+                std::tuple<size_t, size_t, size_t> cutset_key{triplet3_len - cutset.first.count(),
+                                                              subasm_index.at(cutset.first), subasm_index.at(cutset.second)};
+                length_cutsets.push_back(std::make_pair(cutset_key, std::vector<SubassemblyMask>{cutset.first, cutset.second, parents.at(i)}));
+            }
         }
+
+        std::sort(length_cutsets.begin(), length_cutsets.end(),
+                  [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+        std::transform(length_cutsets.begin(), length_cutsets.end(), std::back_inserter(cutsets),
+                       [](const auto &length_cutset) { return length_cutset.second; });
+    }
+
+    for (const auto &two_component_asm : two_component_asms)
+    {
+        size_t first_id{two_component_asm.find_first()};
+        SubassemblyMask first_component(num_components);
+        first_component.set(first_id);
+        cutsets.push_back(std::vector<SubassemblyMask>{first_component, this->canonicalize(two_component_asm - first_component), two_component_asm});
     }
 
-    std::vector<std::vector<Subassembly>> two_component_cutsets{};
-    std::transform(two_component_asms.begin(), two_component_asms.end(), std::back_inserter(two_component_cutsets),
-                   [](const auto &two_component_asm) {
-                       return std::vector<Subassembly>{{two_component_asm.at(0)},
-                                                       {two_component_asm.at(1)},
-                                                       two_component_asm};
-                   });
-    cutsets.insert(cutsets.end(), two_component_cutsets.begin(), two_component_cutsets.end());
+    // Convert back to subassemblies only at the AND-OR graph boundary
+    std::unordered_map<SubassemblyMask, Subassembly> subassemblies{};
+    auto get_subassembly = [this, &subassemblies](const SubassemblyMask &mask) -> const Subassembly & {
+        auto it = subassemblies.find(mask);
+        if (it == subassemblies.end())
+            it = subassemblies.emplace(mask, this->to_subassembly(mask)).first;
+        return it->second;
+    };
 
-    AndOrGraph<Subassembly> ao_graph{};
+    AndOrGraph<Subassembly>::Builder ao_graph{};
+    ao_graph.reserve(subasm_index.size(), cutsets.size());
 
     for (const auto &cutset : cutsets)
-        ao_graph.add_edge(cutset.at(2), std::vector<Subassembly>{cutset.at(0), cutset.at(1)});
+        ao_graph.add_edge(get_subassembly(cutset.at(2)), std::vector<Subassembly>{get_subassembly(cutset.at(0)), get_subassembly(cutset.at(1))});
 
-    return ao_graph;
+    return ao_graph.build();
 }
 
-std::vector<Component> Assembly::get_components() const
+const std::vector<Component> &Assembly::get_components() const
 {
     return this->components;
 }
 
-AndOrGraph<Subassembly> Assembly::get_ao_graph() const
+const AndOrGraph<Subassembly> &Assembly::get_ao_graph() const
 {
     return this->ao_graph;
 }
 
-void Assembly::import_ao_graph(const nlohmann::json &json)
+bool Assembly::has_symmetries() const
+{
+    return !this->symmetry_orbits.empty();
+}
+
+Subassembly Assembly::get_canonical_subassembly(const Subassembly &subassembly) const
+{
+    return this->to_subassembly(this->canonicalize(this->to_mask(subassembly)));
+}
+
+std::vector<Subassembly> Assembly::get_canonical_partition(const std::vector<Subassembly> &subassemblies) const
+{
+    // Signature sort: the disjoint subassemblies are ordered by their components outside of any orbit and the
+    // number of components they take from every orbit. Handing out the components of every orbit in that order
+    // yields the same result for all symmetric images of the partition.
+    SubassemblyMask orbit_components(this->indexed_components.size());
+    for (const auto &orbit : this->symmetry_orbits)
+    {
+        for (int component_id : orbit)
+            orbit_components.set(component_id);
+    }
+
+    std::vector<std::pair<std::pair<SubassemblyMask, std::vector<size_t>>, SubassemblyMask>> signatures{};
+    for (const auto &subassembly : subassemblies)
+    {
+        SubassemblyMask subasm{this->to_mask(subassembly)};
+        std::vector<size_t> orbit_counts{};
+        for (const auto &orbit : this->symmetry_orbits)
+            orbit_counts.push_back(std::count_if(orbit.begin(), orbit.end(), [&subasm](int id) { return subasm.test(id); }));
+        signatures.push_back(std::make_pair(std::make_pair(subasm - orbit_components, orbit_counts), subasm));
+    }
+    std::sort(signatures.begin(), signatures.end(),
+              [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+
+    std::vector<size_t> next_positions(this->symmetry_orbits.size(), 0);
+    std::vector<Subassembly> canonical_subasms{};
+    for (const auto &signature : signatures)
+    {
+        SubassemblyMask canonical_subasm{signature.first.first};
+        for (size_t o{0}; o < this->symmetry_orbits.size(); ++o)
+        {
+            for (size_t i{0}; i < signature.first.second.at(o); ++i)
+                canonical_subasm.set(this->symmetry_orbits.at(o).at(next_positions.at(o)++));
+        }
+        canonical_subasms.push_back(this->to_subassembly(canonical_subasm));
+    }
+    std::sort(canonical_subasms.begin(), canonical_subasms.end());
+    return canonical_subasms;
+}
+
+std::vector<std::vector<Subassembly>> Assembly::get_successors(const Subassembly &subassembly, bool expand_symmetries) const
 {
-    nlohmann::json components = json.at("components");
-    nlohmann::json unions = json.at("unions");
+    if (this->symmetry_orbits.empty())
+        return this->ao_graph.get_successors(subassembly);
+
+    // Resolve the successors of the canonical form and map them back with the inverse permutation. Every edge of
+    // the canonical parent keeps a child that is a subset of the parent, the other part is its complement.
+    SubassemblyMask subasm{this->to_mask(subassembly)};
+    std::vector<int> permutation{this->get_canonical_permutation(subasm)};
+    std::vector<int> inverse_permutation(permutation.size());
+    for (size_t id{0}; id < permutation.size(); ++id)
+        inverse_permutation.at(permutation.at(id)) = static_cast<int>(id);
+    SubassemblyMask canonical_subasm{this->permute(subasm, permutation)};
+
+    std::vector<std::vector<Subassembly>> successors{};
+    std::set<std::vector<Subassembly>> visited{};
+    auto add_successor = [this, &subasm, &successors, &visited](const SubassemblyMask &part) {
+        std::vector<Subassembly> successor{this->to_subassembly(part), this->to_subassembly(subasm - part)};
+        std::sort(successor.begin(), successor.end());
+        if (visited.insert(successor).second)
+            successors.push_back(successor);
+    };
+
+    int canonical_id{};
+    if (!this->ao_graph.get_id(this->to_subassembly(canonical_subasm), canonical_id))
+        return successors;
+
+    for (std::size_t edge{0}; edge < this->ao_graph.get_num_edges(canonical_id); ++edge)
+    {
+        IdRange child_ids{this->ao_graph.get_child_ids(canonical_id, edge)};
+        auto it = std::find_if(child_ids.begin(), child_ids.end(), [this, &canonical_subasm](int child_id) {
+            return this->to_mask(this->ao_graph.get_node(child_id)).is_subset_of(canonical_subasm);
+        });
+        if (it == child_ids.end())
+            continue;
+
+        SubassemblyMask part{this->permute(this->to_mask(this->ao_graph.get_node(*it)), inverse_permutation)};
+        if (!expand_symmetries)
+        {
+            add_successor(part);
+            continue;
+        }
+
+        // symmetric expansion: every choice of the same number of components from every orbit inside the subassembly
+        std::vector<SubassemblyMask> parts{part};
+        for (const auto &orbit : this->symmetry_orbits)
+        {
+            std::vector<int> member_ids{};
+            std::copy_if(orbit.begin(), orbit.end(), std::back_inserter(member_ids), [&subasm](int id) { return subasm.test(id); });
+            std::vector<bool> is_selected(member_ids.size(), false);
+            std::fill(is_selected.begin(), is_selected.begin() + std::count_if(orbit.begin(), orbit.end(), [&part](int id) { return part.test(id); }), true);
+
+            std::vector<SubassemblyMask> extended_parts{};
+            do
+            {
+                for (SubassemblyMask extended_part : parts)
+                {
+                    for (size_t i{0}; i < member_ids.size(); ++i)
+                        extended_part[member_ids.at(i)] = is_selected.at(i);
+                    extended_parts.push_back(extended_part);
+                }
+            } while (std::prev_permutation(is_selected.begin(), is_selected.end()));
+            parts = extended_parts;
+        }
 
-    AndOrGraph<std::string> ao_graph_ids{};
+        for (const auto &symmetric_part : parts)
+            add_successor(symmetric_part);
+    }
+    return successors;
+}
 
-    bool has_union_ids{true};
-    std::vector<int> union_ids{};
-    for (const nlohmann::json &u: unions)
+AndOrGraph<Subassembly> Assembly::get_expanded_ao_graph() const
+{
+    if (this->symmetry_orbits.empty())
+        return this->ao_graph;
+
+    AndOrGraph<Subassembly>::Builder expanded_ao_graph{};
+    std::vector<Subassembly> open_subasms{this->ao_graph.get_root_nodes()};
+    std::unordered_set<Subassembly> visited{open_subasms.begin(), open_subasms.end()};
+    while (!open_subasms.empty())
     {
-        if (u.contains("id"))
-            union_ids.push_back(u.at("id")); // check if every union is accompanied by an id
+        Subassembly subassembly{open_subasms.back()};
+        open_subasms.pop_back();
+
+        for (const auto &children : this->get_successors(subassembly))
+        {
+            expanded_ao_graph.add_edge(subassembly, children);
+            for (const auto &child : children)
+            {
+                if (visited.insert(child).second)
+                    open_subasms.push_back(child);
+            }
+        }
+    }
+    return expanded_ao_graph.build();
+}
+
+bool Assembly::is_supported(const SubassemblyMask &subassembly, const std::unordered_set<SubassemblyMask> &prev_subassemblies) const
+{
+    // a subassembly of length k is only generated as the extension of a known subassembly of length k - 1 by one neighbor
+    for (size_t id{subassembly.find_first()}; id != SubassemblyMask::npos; id = subassembly.find_next(id))
+    {
+        SubassemblyMask reduced{subassembly};
+        reduced.reset(id);
+        if (prev_subassemblies.find(reduced) == prev_subassemblies.end())
+            continue;
+
+        const std::vector<int> &neighbor_ids{this->component_neighbors.at(id)};
+        if (std::any_of(neighbor_ids.begin(), neighbor_ids.end(), [&reduced](int neighbor_id) { return reduced.test(neighbor_id); }))
+            return true;
+    }
+    return false;
+}
+
+AoGraphDiff Assembly::regenerate_ao_graph()
+{
+    std::vector<std::tuple<Subassembly, std::vector<Subassembly>, int>> prev_edges{this->ao_graph.get_edges()};
+    std::vector<Subassembly> prev_nodes{this->ao_graph.get_nodes()};
+    this->ao_graph = this->generate_ao_graph();
+    std::vector<std::tuple<Subassembly, std::vector<Subassembly>, int>> edges{this->ao_graph.get_edges()};
+    std::vector<Subassembly> nodes{this->ao_graph.get_nodes()};
+
+    auto get_key = [](const std::tuple<Subassembly, std::vector<Subassembly>, int> &edge) {
+        return std::make_pair(std::get<0>(edge), std::get<1>(edge));
+    };
+    std::set<std::pair<Subassembly, std::vector<Subassembly>>> prev_edge_keys{};
+    std::transform(prev_edges.begin(), prev_edges.end(), std::inserter(prev_edge_keys, prev_edge_keys.end()), get_key);
+    std::set<std::pair<Subassembly, std::vector<Subassembly>>> edge_keys{};
+    std::transform(edges.begin(), edges.end(), std::inserter(edge_keys, edge_keys.end()), get_key);
+    std::set<Subassembly> prev_node_set{prev_nodes.begin(), prev_nodes.end()};
+    std::set<Subassembly> node_set{nodes.begin(), nodes.end()};
+
+    AoGraphDiff diff{};
+    std::copy_if(nodes.begin(), nodes.end(), std::back_inserter(diff.added_nodes),
+                 [&prev_node_set](const Subassembly &node) { return (prev_node_set.find(node) == prev_node_set.end()); });
+    std::copy_if(prev_nodes.begin(), prev_nodes.end(), std::back_inserter(diff.removed_nodes),
+                 [&node_set](const Subassembly &node) { return (node_set.find(node) == node_set.end()); });
+    std::copy_if(edges.begin(), edges.end(), std::back_inserter(diff.added_edges),
+                 [&prev_edge_keys, &get_key](const auto &edge) { return (prev_edge_keys.find(get_key(edge)) == prev_edge_keys.end()); });
+    std::copy_if(prev_edges.begin(), prev_edges.end(), std::back_inserter(diff.removed_edges),
+                 [&edge_keys, &get_key](const auto &edge) { return (edge_keys.find(get_key(edge)) == edge_keys.end()); });
+    return diff;
+}
+
+AoGraphDiff Assembly::update_ao_graph(const std::vector<Component> &prev_components, const std::vector<std::pair<int, SubassemblyMask>> &changed_rules)
+{
+    // An AND-OR graph reduced by symmetries can't be updated subassembly by subassembly, since the change may
+    // break the symmetries it was reduced by
+    bool was_reduced{!this->symmetry_orbits.empty()};
+    this->compute_symmetry_orbits();
+    if (was_reduced || !this->symmetry_orbits.empty())
+        return this->regenerate_ao_graph();
+
+    // Only subassemblies whose feasibility may have changed (supersets of a changed rule without its component) and
+    // subassemblies whose generating subassemblies were added or removed are revalidated, level by level, so that the
+    // result matches what generate_ao_graph() would build for the updated assembly.
+    size_t num_components{this->components.size()};
+    auto is_touched = [&changed_rules](const SubassemblyMask &subassembly) {
+        return std::any_of(changed_rules.begin(), changed_rules.end(), [&subassembly](const auto &rule) {
+            return ((rule.first < 0 || !subassembly.test(rule.first)) && rule.second.is_subset_of(subassembly));
+        });
+    };
+
+    std::vector<std::tuple<Subassembly, std::vector<Subassembly>, int>> prev_edges{this->ao_graph.get_edges()};
+    std::vector<std::unordered_set<SubassemblyMask>> levels(num_components + 1);
+    for (const auto &edge : prev_edges)
+    {
+        SubassemblyMask parent{this->to_mask(std::get<0>(edge))};
+        levels.at(parent.count()).insert(parent);
+        for (const auto &child : std::get<1>(edge))
+        {
+            SubassemblyMask child_mask{this->to_mask(child)};
+            levels.at(child_mask.count()).insert(child_mask);
+        }
+    }
+    for (const auto &component : prev_components)
+        levels.at(1).insert(this->to_mask(Subassembly{component}));
+    SubassemblyMask prev_complete_asm{this->to_mask(prev_components)};
+    SubassemblyMask complete_asm{this->to_mask(this->components)};
+    if (prev_complete_asm.any())
+        levels.at(prev_complete_asm.count()).insert(prev_complete_asm);
+
+    std::vector<std::vector<SubassemblyMask>> added(num_components + 1);
+    std::vector<std::vector<SubassemblyMask>> removed(num_components + 1);
+
+    for (const auto &component : this->components)
+    {
+        SubassemblyMask one_component_asm{this->to_mask(Subassembly{component})};
+        if (levels.at(1).insert(one_component_asm).second)
+            added.at(1).push_back(one_component_asm);
+    }
+
+    // two-component subassemblies are the feasible connections, there are only as many as connections
+    std::unordered_set<SubassemblyMask> two_component_asms{};
+    for (const auto &connection : this->connection_graph.get_edges())
+    {
+        SubassemblyMask two_component_asm{this->to_mask(Subassembly{connection.first, connection.second})};
+        if (this->check_feasibility(two_component_asm))
+            two_component_asms.insert(two_component_asm);
+    }
+    for (const auto &two_component_asm : levels.at(2))
+    {
+        if (two_component_asms.find(two_component_asm) == two_component_asms.end())
+            removed.at(2).push_back(two_component_asm);
+    }
+    for (const auto &two_component_asm : two_component_asms)
+    {
+        if (levels.at(2).find(two_component_asm) == levels.at(2).end())
+            added.at(2).push_back(two_component_asm);
+    }
+    levels.at(2) = two_component_asms;
+
+    ThreadPool thread_pool{this->num_threads};
+
+    for (size_t subasm_length{3}; subasm_length < num_components; ++subasm_length)
+    {
+        const std::unordered_set<SubassemblyMask> &prev_subassemblies{levels.at(subasm_length - 1)};
+        std::unordered_set<SubassemblyMask> &subassemblies{levels.at(subasm_length)};
+
+        // known subassemblies that have to be revalidated
+        std::vector<SubassemblyMask> revalidated{};
+        std::unordered_set<SubassemblyMask> visited{};
+        if (!changed_rules.empty())
+        {
+            for (const auto &subassembly : subassemblies)
+            {
+                if (is_touched(subassembly) && visited.insert(subassembly).second)
+                    revalidated.push_back(subassembly);
+            }
+        }
+        for (const auto &removed_subasm : removed.at(subasm_length - 1))
+        {
+            for (int neighbor_id : this->get_neighbors(removed_subasm))
+            {
+                SubassemblyMask extension{removed_subasm};
+                extension.set(neighbor_id);
+                if (subassemblies.find(extension) != subassemblies.end() && visited.insert(extension).second)
+                    revalidated.push_back(extension);
+            }
+        }
+        if (prev_complete_asm != complete_asm && prev_complete_asm.count() == subasm_length && visited.insert(prev_complete_asm).second)
+            revalidated.push_back(prev_complete_asm); // no longer the complete assembly, hence no longer known unconditionally
+
+        // unknown subassemblies that extend an added or a touched known subassembly
+        std::vector<SubassemblyMask> candidates{};
+        auto add_candidate = [&subassemblies, &visited, &candidates](const SubassemblyMask &extension) {
+            if (subassemblies.find(extension) == subassemblies.end() && visited.insert(extension).second)
+                candidates.push_back(extension);
+        };
+        for (const auto &added_subasm : added.at(subasm_length - 1))
+        {
+            for (int neighbor_id : this->get_neighbors(added_subasm))
+            {
+                SubassemblyMask extension{added_subasm};
+                extension.set(neighbor_id);
+                add_candidate(extension);
+            }
+        }
+        for (const auto &one_component_asm : added.at(1))
+        {
+            // every known subassembly next to a new component can be extended by it
+            int component_id{static_cast<int>(one_component_asm.find_first())};
+            const std::vector<int> &neighbor_ids{this->component_neighbors.at(component_id)};
+            for (const auto &prev_subasm : prev_subassemblies)
+            {
+                if (std::any_of(neighbor_ids.begin(), neighbor_ids.end(), [&prev_subasm](int neighbor_id) { return prev_subasm.test(neighbor_id); }))
+                    add_candidate(prev_subasm | one_component_asm);
+            }
+        }
+        if (!changed_rules.empty())
+        {
+            for (const auto &prev_subasm : prev_subassemblies)
+            {
+                // a touched extension misses at most one component of a changed rule
+                bool is_close = std::any_of(changed_rules.begin(), changed_rules.end(), [&prev_subasm](const auto &rule) {
+                    return ((rule.first < 0 || !prev_subasm.test(rule.first)) && (rule.second - prev_subasm).count() <= 1);
+                });
+                if (!is_close)
+                    continue;
+
+                for (int neighbor_id : this->get_neighbors(prev_subasm))
+                {
+                    SubassemblyMask extension{prev_subasm};
+                    extension.set(neighbor_id);
+                    if (is_touched(extension))
+                        add_candidate(extension);
+                }
+            }
+        }
+
+        std::vector<char> is_valid(revalidated.size());
+        thread_pool.parallel_for(revalidated.size(), [this, &revalidated, &prev_subassemblies, &is_valid](size_t i) {
+            is_valid.at(i) = this->check_feasibility(revalidated.at(i)) && this->is_supported(revalidated.at(i), prev_subassemblies);
+        });
+        std::vector<char> is_feasible(candidates.size());
+        thread_pool.parallel_for(candidates.size(), [this, &candidates, &is_feasible](size_t i) {
+            is_feasible.at(i) = this->check_feasibility(candidates.at(i));
+        });
+
+        for (size_t i{0}; i < revalidated.size(); ++i)
+        {
+            if (!is_valid.at(i))
+            {
+                subassemblies.erase(revalidated.at(i));
+                removed.at(subasm_length).push_back(revalidated.at(i));
+            }
+        }
+        for (size_t i{0}; i < candidates.size(); ++i)
+        {
+            if (is_feasible.at(i))
+            {
+                subassemblies.insert(candidates.at(i));
+                added.at(subasm_length).push_back(candidates.at(i));
+            }
+        }
+    }
+
+    if (num_components > 2 && levels.at(num_components).insert(complete_asm).second)
+        added.at(num_components).push_back(complete_asm);
+
+    std::unordered_set<SubassemblyMask> removed_subasms{};
+    std::unordered_set<SubassemblyMask> added_subasms{};
+    AoGraphDiff diff{};
+    for (size_t subasm_length{1}; subasm_length <= num_components; ++subasm_length)
+    {
+        for (const auto &subassembly : removed.at(subasm_length))
+        {
+            removed_subasms.insert(subassembly);
+            diff.removed_nodes.push_back(this->to_subassembly(subassembly));
+        }
+        for (const auto &subassembly : added.at(subasm_length))
+        {
+            added_subasms.insert(subassembly);
+            diff.added_nodes.push_back(this->to_subassembly(subassembly));
+        }
+    }
+
+    // Edges with a removed subassembly are dropped, all others stay valid and keep their order and ids
+    size_t num_subasms{0};
+    for (const auto &subassemblies : levels)
+        num_subasms += subassemblies.size();
+
+    AndOrGraph<Subassembly>::Builder ao_graph{};
+    ao_graph.reserve(num_subasms, prev_edges.size());
+    for (const auto &edge : prev_edges)
+    {
+        bool is_removed{removed_subasms.find(this->to_mask(std::get<0>(edge))) != removed_subasms.end()};
+        for (const auto &child : std::get<1>(edge))
+            is_removed = is_removed || removed_subasms.find(this->to_mask(child)) != removed_subasms.end();
+
+        if (is_removed)
+            diff.removed_edges.push_back(edge);
         else
+            ao_graph.add_edge(std::get<0>(edge), std::get<1>(edge), std::get<2>(edge));
+    }
+
+    // New cutsets either split an added subassembly or have an added subassembly as one of their parts
+    std::unordered_map<SubassemblyMask, size_t> subasm_index{};
+    for (const auto &subassemblies : levels)
+    {
+        size_t i{0};
+        for (const auto &subassembly : subassemblies)
+            subasm_index.emplace(subassembly, i++);
+    }
+
+    std::vector<SubassemblyMask> added_parents{};
+    for (size_t subasm_length{3}; subasm_length <= num_components; ++subasm_length)
+        added_parents.insert(added_parents.end(), added.at(subasm_length).begin(), added.at(subasm_length).end());
+    std::vector<std::vector<std::pair<SubassemblyMask, SubassemblyMask>>> parent_cutsets(added_parents.size());
+    thread_pool.parallel_for(added_parents.size(), [this, &added_parents, &parent_cutsets, &subasm_index](size_t i) {
+        parent_cutsets.at(i) = this->enumerate_cutsets(added_parents.at(i), subasm_index);
+    });
+
+    std::vector<std::vector<SubassemblyMask>> cutsets{};
+    for (size_t i{0}; i < added_parents.size(); ++i)
+    {
+        for (const auto &cutset : parent_cutsets.at(i))
+            cutsets.push_back(std::vector<SubassemblyMask>{cutset.first, cutset.second, added_parents.at(i)});
+    }
+    for (const auto &two_component_asm : added.at(2))
+    {
+        SubassemblyMask first_component(num_components);
+        first_component.set(two_component_asm.find_first());
+        cutsets.push_back(std::vector<SubassemblyMask>{first_component, two_component_asm - first_component, two_component_asm});
+    }
+    for (size_t subasm_length{3}; subasm_length <= num_components; ++subasm_length)
+    {
+        for (const auto &parent : levels.at(subasm_length))
         {
-            std::cout << "[Import AND-OR graph]: Union ID(s) missing in the JSON object. Using default ids instead."
+            if (added_subasms.find(parent) != added_subasms.end())
+                continue;
+
+            for (const auto &added_subasm : added_subasms)
+            {
+                if (added_subasm.count() >= subasm_length || !added_subasm.is_subset_of(parent))
+                    continue;
+
+                // a split into two added subassemblies is reported once, with the larger part first
+                SubassemblyMask complement{parent - added_subasm};
+                auto it = subasm_index.find(complement);
+                if (it == subasm_index.end())
+                    continue;
+                if (added_subasms.find(complement) != added_subasms.end() &&
+                    (complement.count() > added_subasm.count() || (complement.count() == added_subasm.count() && complement < added_subasm)))
+                    continue;
+
+                cutsets.push_back(std::vector<SubassemblyMask>{added_subasm, complement, parent});
+            }
+        }
+    }
+
+    for (const auto &cutset : cutsets)
+    {
+        Subassembly parent{this->to_subassembly(cutset.at(2))};
+        std::vector<Subassembly> children{this->to_subassembly(cutset.at(0)), this->to_subassembly(cutset.at(1))};
+        diff.added_edges.push_back(std::make_tuple(parent, children, -1));
+        ao_graph.add_edge(std::move(parent), std::move(children));
+    }
+    this->ao_graph = ao_graph.build();
+
+    return diff;
+}
+
+AoGraphDiff Assembly::add_technical_constraint(const Component &component, const Subassembly &subassembly)
+{
+    std::vector<Subassembly> &constraints{this->technical_constraints[component]};
+    Subassembly rule{subassembly};
+    std::sort(rule.begin(), rule.end());
+    bool is_known = std::any_of(constraints.begin(), constraints.end(), [&rule](Subassembly constraint) {
+        std::sort(constraint.begin(), constraint.end());
+        return (constraint == rule);
+    });
+    if (is_known)
+        return AoGraphDiff{};
+
+    constraints.push_back(subassembly);
+    std::vector<std::pair<int, SubassemblyMask>> changed_rules{this->compile_rules({{component, {subassembly}}})};
+    this->compile_feasibility_rules();
+    return this->update_ao_graph(this->components, changed_rules);
+}
+
+AoGraphDiff Assembly::remove_technical_constraint(const Component &component, const Subassembly &subassembly)
+{
+    auto it = this->technical_constraints.find(component);
+    if (it == this->technical_constraints.end())
+        return AoGraphDiff{};
+
+    Subassembly rule{subassembly};
+    std::sort(rule.begin(), rule.end());
+    auto rule_it = std::find_if(it->second.begin(), it->second.end(), [&rule](Subassembly constraint) {
+        std::sort(constraint.begin(), constraint.end());
+        return (constraint == rule);
+    });
+    if (rule_it == it->second.end())
+        return AoGraphDiff{};
+
+    it->second.erase(rule_it);
+    if (it->second.empty())
+        this->technical_constraints.erase(it);
+    std::vector<std::pair<int, SubassemblyMask>> changed_rules{this->compile_rules({{component, {subassembly}}})};
+    this->compile_feasibility_rules();
+    return this->update_ao_graph(this->components, changed_rules);
+}
+
+AoGraphDiff Assembly::update_blocking_rules(const Component &component)
+{
+    // the rules of the component are the only ones that depend on its successors in the obstruction graphs
+    if (this->component_ids.find(component) == this->component_ids.end())
+        return AoGraphDiff{};
+
+    std::vector<Subassembly> &rules{this->blocking_rules[component]};
+    std::vector<Subassembly> new_rules{this->compute_blocking_rules(component)};
+    if (new_rules == rules)
+        return AoGraphDiff{};
+
+    std::vector<std::pair<int, SubassemblyMask>> changed_rules{this->compile_rules({{component, rules}})};
+    std::vector<std::pair<int, SubassemblyMask>> new_rule_masks{this->compile_rules({{component, new_rules}})};
+    changed_rules.insert(changed_rules.end(), new_rule_masks.begin(), new_rule_masks.end());
+
+    rules = new_rules;
+    this->compile_feasibility_rules();
+    return this->update_ao_graph(this->components, changed_rules);
+}
+
+AoGraphDiff Assembly::add_obstruction_edge(size_t direction, const Component &component, const Component &blocking_component)
+{
+    if (direction >= this->obstruction_graphs.size())
+    {
+        std::cerr << "[Update AND-OR graph]: There is no obstruction graph with index " << direction << '.'
+                  << std::endl;
+        return AoGraphDiff{};
+    }
+
+    this->obstruction_graphs.at(direction).add_edge(component, blocking_component);
+    return this->update_blocking_rules(component);
+}
+
+AoGraphDiff Assembly::remove_obstruction_edge(size_t direction, const Component &component, const Component &blocking_component)
+{
+    if (direction >= this->obstruction_graphs.size())
+    {
+        std::cerr << "[Update AND-OR graph]: There is no obstruction graph with index " << direction << '.'
+                  << std::endl;
+        return AoGraphDiff{};
+    }
+
+    // DiGraph has no edge removal, hence the graph is rebuilt without the edge
+    const DiGraph<Component> &obstr_graph{this->obstruction_graphs.at(direction)};
+    const std::vector<std::pair<int, int>> &edge_ids{obstr_graph.get_edge_ids()};
+    DiGraph<Component> reduced_graph{obstr_graph.get_name()};
+    for (std::size_t edge_id{0}; edge_id < edge_ids.size(); ++edge_id)
+    {
+        const Component &u{obstr_graph.get_node(edge_ids.at(edge_id).first)};
+        const Component &v{obstr_graph.get_node(edge_ids.at(edge_id).second)};
+        if (!(u == component && v == blocking_component))
+            reduced_graph.add_edge(u, v, obstr_graph.get_edge_attrs().at(obstr_graph.get_edge_attr_ids().at(edge_id)));
+    }
+    this->obstruction_graphs.at(direction) = reduced_graph;
+    return this->update_blocking_rules(component);
+}
+
+AoGraphDiff Assembly::add_component(const Component &component, const std::vector<Component> &neighbors)
+{
+    if (this->component_ids.find(component) != this->component_ids.end())
+    {
+        std::cerr << "[Update AND-OR graph]: Component " << component << " is already part of the assembly."
+                  << std::endl;
+        return AoGraphDiff{};
+    }
+
+    std::vector<Component> prev_components{this->components};
+    for (const auto &neighbor : neighbors)
+    {
+        if (this->component_ids.find(neighbor) != this->component_ids.end())
+            this->connection_graph.add_edge(component, neighbor);
+        else
+            std::cerr << "[Update AND-OR graph]: Neighbor " << neighbor << " is not part of the assembly. Skipping it."
                       << std::endl;
-            has_union_ids = false;
-            break;
+    }
+    this->components.push_back(component);
+    this->index_components();
+
+    // Only the component itself and components it was already blocking in the obstruction graphs get new rules.
+    // Subassemblies without the new component keep their feasibility, rules that now include it only constrain
+    // subassemblies that contain it.
+    this->blocking_rules[component] = this->compute_blocking_rules(component);
+    for (const auto &obstr_graph : this->obstruction_graphs)
+    {
+        int node_id{};
+        if (!obstr_graph.get_id(component, node_id))
+            continue;
+
+        for (int predecessor_id : obstr_graph.get_predecessor_ids(node_id))
+        {
+            const Component &predecessor{obstr_graph.get_node(predecessor_id)};
+            if (this->component_ids.find(predecessor) != this->component_ids.end())
+                this->blocking_rules[predecessor] = this->compute_blocking_rules(predecessor);
         }
     }
+    this->compile_feasibility_rules();
+    return this->update_ao_graph(prev_components, {});
+}
+
+std::uint64_t Assembly::compute_content_hash() const
+{
+    // Textual description of everything the AND-OR graph is derived from. The order of the generated nodes and
+    // edges follows the order in which components, connections and obstructions were added, hence these are
+    // described in that order: equal products built in a different order get different cache entries. Technical
+    // constraints only decide feasibility and are sorted. Names are length-prefixed, so that names containing
+    // separators can't make two descriptions equal.
+    std::ostringstream ss_content{};
+    ss_content << "ao_graph_snapshot_v" << snapshot_version << '\n';
+
+    auto append_name = [&ss_content](const std::string &name) {
+        ss_content << name.size() << ':' << name;
+    };
+
+    for (const auto &component : this->components)
+    {
+        append_name(component.get_name());
+        append_name(component.get_equivalence_class());
+    }
+    ss_content << '\n';
+
+    for (const auto &connection : this->connection_graph.get_edges())
+    {
+        append_name(connection.first.get_name());
+        append_name(connection.second.get_name());
+    }
+    ss_content << '\n';
+
+    for (const auto &obstr_graph : this->obstruction_graphs)
+    {
+        for (const std::pair<int, int> &obstruction : obstr_graph.get_edge_ids())
+        {
+            append_name(obstr_graph.get_node(obstruction.first).get_name());
+            append_name(obstr_graph.get_node(obstruction.second).get_name());
+        }
+        ss_content << '\n';
+    }
+
+    std::vector<std::pair<Component, std::vector<Subassembly>>> tech_constraints{this->technical_constraints.begin(), this->technical_constraints.end()};
+    std::sort(tech_constraints.begin(), tech_constraints.end());
+    for (auto &constraint : tech_constraints)
+    {
+        for (auto &rule : constraint.second)
+            std::sort(rule.begin(), rule.end());
+        std::sort(constraint.second.begin(), constraint.second.end());
+
+        append_name(constraint.first.get_name());
+        ss_content << constraint.second.size();
+        for (const auto &rule : constraint.second)
+        {
+            ss_content << ',' << rule.size();
+            for (const auto &component : rule)
+                append_name(component.get_name());
+        }
+        ss_content << '\n';
+    }
+
+    return utils::fnv1a_hash(ss_content.str());
+}
+
+std::string Assembly::get_cache_file_path(const std::string &cache_dir) const
+{
+    std::ostringstream ss_file_path{};
+    ss_file_path << cache_dir << "/ao_graph_" << std::hex << std::setw(16) << std::setfill('0')
+                 << this->compute_content_hash() << ".bin";
+    return ss_file_path.str();
+}
+
+bool Assembly::load_cached_ao_graph(const std::string &cache_dir)
+{
+    std::string file_path{this->get_cache_file_path(cache_dir)};
+    std::ifstream file_stream{file_path, std::ios_base::binary};
+    if (!file_stream.is_open())
+        return false;
+
+    std::vector<Component> snapshot_components{};
+    AndOrGraph<Subassembly> snapshot_ao_graph{};
+    if (!this->read_snapshot(file_stream, snapshot_components, snapshot_ao_graph) ||
+        snapshot_components != this->components)
+    {
+        std::cerr << "[AND-OR graph cache]: Ignoring stale or corrupt cache file: " << file_path
+                  << std::endl;
+        return false;
+    }
+
+    this->ao_graph = snapshot_ao_graph;
+    return true;
+}
+
+void Assembly::store_cached_ao_graph(const std::string &cache_dir) const
+{
+    std::error_code error{};
+    std::filesystem::create_directories(cache_dir, error);
+
+    std::string file_path{this->get_cache_file_path(cache_dir)};
+    std::ofstream file_stream{file_path, std::ios_base::binary | std::ios_base::trunc};
+    if (!file_stream.is_open())
+        std::cerr << "[AND-OR graph cache]: Couldn't open cache file: " << file_path
+                  << std::endl;
+    else
+        this->write_snapshot(file_stream);
+}
+
+void Assembly::write_snapshot(std::ostream &os) const
+{
+    // Layout (native byte order):
+    //   magic "AOGS" | u32 version | u64 FNV-1a checksum of the payload, i.e. of everything that follows
+    //   u32 #components | per component: u32 #chars, name chars, u32 #chars, equivalence class chars (in order of 'components')
+    //   u32 #nodes      | per node, in order of node ids: u64 words of its component mask  (bit i: i-th component by name)
+    //   u32 #unions     | per union, grouped by parent in order of node ids: u32 parent, u32 #children, u32 children..., i32 id
+    std::uint32_t num_words{static_cast<std::uint32_t>((this->indexed_components.size() + 63) / 64)};
+
+    std::ostringstream ss_payload{};
+    utils::write_binary(ss_payload, static_cast<std::uint32_t>(this->components.size()));
+    for (const auto &component : this->components)
+    {
+        for (const std::string &text : {component.get_name(), component.get_equivalence_class()})
+        {
+            utils::write_binary(ss_payload, static_cast<std::uint32_t>(text.size()));
+            ss_payload.write(text.data(), text.size());
+        }
+    }
+
+    std::uint32_t num_nodes{static_cast<std::uint32_t>(this->ao_graph.get_num_nodes())};
+    utils::write_binary(ss_payload, num_nodes);
+    for (std::uint32_t node_id{0}; node_id < num_nodes; ++node_id)
+    {
+        std::vector<std::uint64_t> words(num_words, 0);
+        for (const auto &component : this->ao_graph.get_node(node_id))
+        {
+            int component_id{this->component_ids.at(component)};
+            words.at(component_id / 64) |= (std::uint64_t{1} << (component_id % 64));
+        }
+        for (std::uint64_t word : words)
+            utils::write_binary(ss_payload, word);
+    }
+
+    std::uint32_t num_edges{0};
+    for (std::uint32_t node_id{0}; node_id < num_nodes; ++node_id)
+        num_edges += this->ao_graph.get_num_edges(node_id);
+    utils::write_binary(ss_payload, num_edges);
+    for (std::uint32_t node_id{0}; node_id < num_nodes; ++node_id)
+    {
+        for (std::size_t edge{0}; edge < this->ao_graph.get_num_edges(node_id); ++edge)
+        {
+            IdRange child_ids{this->ao_graph.get_child_ids(node_id, edge)};
+            utils::write_binary(ss_payload, node_id);
+            utils::write_binary(ss_payload, static_cast<std::uint32_t>(child_ids.size()));
+            for (int child_id : child_ids)
+                utils::write_binary(ss_payload, static_cast<std::uint32_t>(child_id));
+            utils::write_binary(ss_payload, static_cast<std::int32_t>(this->ao_graph.get_edge_id(node_id, edge)));
+        }
+    }
+
+    std::string payload{ss_payload.str()};
+    os.write(snapshot_magic, sizeof(snapshot_magic));
+    utils::write_binary(os, snapshot_version);
+    utils::write_binary(os, utils::fnv1a_hash(payload));
+    os.write(payload.data(), payload.size());
+}
+
+bool Assembly::read_snapshot(std::istream &is, std::vector<Component> &out_components, AndOrGraph<Subassembly> &out_ao_graph) const
+{
+    char magic[sizeof(snapshot_magic)]{};
+    std::uint32_t version{};
+    std::uint64_t checksum{};
+    if (!is.read(magic, sizeof(magic)) || !std::equal(magic, magic + sizeof(magic), snapshot_magic) ||
+        !utils::read_binary(is, version) || version != snapshot_version ||
+        !utils::read_binary(is, checksum))
+        return false;
+
+    // The payload is checksummed in a first pass, so that a corrupt file is rejected before anything is allocated
+    // from its counts. The stream is then rewound to parse it.
+    std::istream::pos_type payload_begin{is.tellg()};
+    if (payload_begin == std::istream::pos_type(-1))
+        return false;
+
+    std::uint64_t payload_hash{utils::fnv1a_hash("")};
+    char buffer[4096];
+    while (is.read(buffer, sizeof(buffer)) || is.gcount() > 0)
+        payload_hash = utils::fnv1a_hash(std::string(buffer, is.gcount()), payload_hash);
+    is.clear();
+    if (payload_hash != checksum || !is.seekg(payload_begin))
+        return false;
+
+    std::uint32_t num_components{};
+    if (!utils::read_binary(is, num_components))
+        return false;
+
+    out_components.clear();
+    for (std::uint32_t i{0}; i < num_components; ++i)
+    {
+        std::string texts[2]{}; // name, equivalence class
+        for (std::string &text : texts)
+        {
+            std::uint32_t num_chars{};
+            if (!utils::read_binary(is, num_chars))
+                return false;
+
+            // read in chunks, so that a corrupt length fails at the end of the stream instead of allocating it
+            text.clear();
+            while (text.size() < num_chars)
+            {
+                std::size_t num_read{text.size()};
+                text.resize(num_read + std::min<std::size_t>(num_chars - num_read, 4096));
+                if (!is.read(&text[num_read], text.size() - num_read))
+                    return false;
+            }
+        }
+        out_components.push_back(Component{texts[0], texts[1]});
+    }
+
+    std::vector<Component> sorted_components{out_components};
+    std::sort(sorted_components.begin(), sorted_components.end());
+    std::uint32_t num_words{static_cast<std::uint32_t>((sorted_components.size() + 63) / 64)};
+
+    std::uint32_t num_nodes{};
+    if (!utils::read_binary(is, num_nodes))
+        return false;
+
+    // nodes are added first, so that they keep their ids
+    AndOrGraph<Subassembly>::Builder ao_graph{};
+    std::vector<Subassembly> nodes{};
+    for (std::uint32_t i{0}; i < num_nodes; ++i)
+    {
+        Subassembly node{};
+        for (std::uint32_t w{0}; w < num_words; ++w)
+        {
+            std::uint64_t word{};
+            if (!utils::read_binary(is, word))
+                return false;
+
+            for (std::uint32_t bit{0}; bit < 64; ++bit)
+            {
+                if (word & (std::uint64_t{1} << bit))
+                {
+                    std::size_t component_id{w * std::size_t{64} + bit};
+                    if (component_id >= sorted_components.size())
+                        return false;
+                    node.push_back(sorted_components.at(component_id));
+                }
+            }
+        }
+        ao_graph.add_node(node);
+        nodes.push_back(node);
+    }
+
+    std::uint32_t num_edges{};
+    if (!utils::read_binary(is, num_edges))
+        return false;
+
+    for (std::uint32_t i{0}; i < num_edges; ++i)
+    {
+        std::uint32_t parent_id{};
+        std::uint32_t num_children{};
+        if (!utils::read_binary(is, parent_id) || !utils::read_binary(is, num_children) || parent_id >= nodes.size())
+            return false;
+
+        std::vector<Subassembly> children{};
+        for (std::uint32_t c{0}; c < num_children; ++c)
+        {
+            std::uint32_t child_id{};
+            if (!utils::read_binary(is, child_id) || child_id >= nodes.size())
+                return false;
+            children.push_back(nodes.at(child_id));
+        }
+
+        std::int32_t edge_id{};
+        if (!utils::read_binary(is, edge_id))
+            return false;
+
+        ao_graph.add_edge(nodes.at(parent_id), std::move(children), edge_id);
+    }
+    out_ao_graph = ao_graph.build();
+    return true;
+}
+
+void Assembly::export_ao_graph_snapshot(const std::string &file_path) const
+{
+    std::ofstream file_stream{file_path, std::ios_base::binary | std::ios_base::trunc};
+    if (!file_stream.is_open())
+        std::cerr << "[Export AND-OR graph]: Couldn't open output file: " << file_path
+                  << std::endl;
+    else
+        this->write_snapshot(file_stream);
+}
+
+bool Assembly::import_ao_graph_snapshot(const std::string &file_path)
+{
+    std::ifstream file_stream{file_path, std::ios_base::binary};
+    if (!file_stream.is_open())
+    {
+        std::cerr << "[Import AND-OR graph]: Snapshot file doesn't exist: " << file_path
+                  << std::endl;
+        return false;
+    }
+
+    std::vector<Component> snapshot_components{};
+    AndOrGraph<Subassembly> snapshot_ao_graph{};
+    if (!this->read_snapshot(file_stream, snapshot_components, snapshot_ao_graph))
+    {
+        std::cerr << "[Import AND-OR graph]: Invalid or truncated snapshot file: " << file_path
+                  << std::endl;
+        return false;
+    }
+
+    this->ao_graph = snapshot_ao_graph;
+    this->components = snapshot_components;
+    this->index_components();
+    this->compile_feasibility_rules();
+    this->compute_symmetry_orbits();
+    return true;
+}
+
+void Assembly::build_ao_graph(const AoGraphDescription &description)
+{
+    const std::vector<AoGraphUnion> &unions{description.unions};
+
+    bool has_union_ids{std::all_of(unions.begin(), unions.end(), [](const AoGraphUnion &u) { return u.has_id; })}; // check if every union is accompanied by an id
+    if (!has_union_ids)
+        std::cout << "[Import AND-OR graph]: Union ID(s) missing in the JSON object. Using default ids instead."
+                  << std::endl;
 
     bool has_unique_union_ids{false};
     if (has_union_ids)
     {
+        std::vector<int> union_ids{};
+        std::transform(unions.begin(), unions.end(), std::back_inserter(union_ids), [](const AoGraphUnion &u) { return u.id; });
         std::sort(union_ids.begin(), union_ids.end());
         has_unique_union_ids = std::adjacent_find(union_ids.begin(), union_ids.end()) == union_ids.end(); // check if every union_id is unique
         if (!has_unique_union_ids)
@@ -263,83 +1517,139 @@ void Assembly::import_ao_graph(const nlohmann::json &json)
                       << std::endl;
     }
 
-    for (const nlohmann::json &u: unions)
+    // Dense indices of the component ids in order of first appearance, the order in which an AndOrGraph<std::string> built from the unions would store its nodes
+    std::unordered_map<std::string, size_t> comp_indices{};
+    std::vector<std::string> comp_ids{};
+    std::vector<std::vector<size_t>> union_children(unions.size());
+    std::vector<size_t> union_parents(unions.size());
+    auto get_comp_index = [&comp_indices, &comp_ids](const std::string &comp_id) {
+        auto it = comp_indices.find(comp_id);
+        if (it != comp_indices.end())
+            return it->second;
+        comp_indices.emplace(comp_id, comp_ids.size());
+        comp_ids.push_back(comp_id);
+        return comp_ids.size() - 1;
+    };
+    for (size_t i = 0; i < unions.size(); ++i)
     {
-        if (has_union_ids && has_unique_union_ids)
-            ao_graph_ids.add_edge(u.at("parent_component"), u.at("child_components"), u.at("id"));
-        else
-            ao_graph_ids.add_edge(u.at("parent_component"), u.at("child_components"));
+        union_parents.at(i) = get_comp_index(unions.at(i).parent_component);
+
+        std::vector<std::string> child_comp_ids{unions.at(i).child_components};
+        for (const std::string &child_comp_id : child_comp_ids)
+            get_comp_index(child_comp_id);
+        std::sort(child_comp_ids.begin(), child_comp_ids.end());
+        child_comp_ids.erase(std::unique(child_comp_ids.begin(), child_comp_ids.end()), child_comp_ids.end());
+        for (const std::string &child_comp_id : child_comp_ids)
+            union_children.at(i).push_back(comp_indices.at(child_comp_id));
     }
 
-    std::vector<std::string> leaf_comp_ids{ao_graph_ids.get_leaf_nodes()};
-    std::unordered_map<std::string, Subassembly> comp_subasm_mapping{};
-    for (const std::string &leaf_comp_id : leaf_comp_ids)
-        comp_subasm_mapping.emplace(std::make_pair(leaf_comp_id, Subassembly{{Component{components.at(leaf_comp_id).at("label")}}}));
-    std::vector<std::string> component_mapping_ids{};
-    for (auto it = comp_subasm_mapping.begin(); it != comp_subasm_mapping.end(); ++it) 
-        component_mapping_ids.push_back(it->first);
+    std::vector<std::vector<size_t>> parent_unions(comp_ids.size());
+    std::vector<std::vector<size_t>> child_unions(comp_ids.size());
+    for (size_t i = 0; i < unions.size(); ++i)
+    {
+        parent_unions.at(union_parents.at(i)).push_back(i);
+        for (size_t child : union_children.at(i))
+            child_unions.at(child).push_back(i);
+    }
 
-    std::set<std::string> open_union_ids{};
-    for (const std::string &leaf_comp_id : leaf_comp_ids)
+    // Leaf components are never the parent of a union
+    std::vector<Component> comps{};
+    std::vector<size_t> leaf_indices{};
+    for (size_t c = 0; c < comp_ids.size(); ++c)
     {
-        std::vector<std::string> parent_unions = components.at(leaf_comp_id).at("parent_unions");
-        std::copy(parent_unions.begin(), parent_unions.end(), std::inserter(open_union_ids, open_union_ids.end()));
+        if (!parent_unions.at(c).empty())
+            continue;
+
+        auto it = description.component_labels.find(comp_ids.at(c));
+        if (it == description.component_labels.end())
+        {
+            std::cerr << "[Import AND-OR graph]: Component " << comp_ids.at(c) << " has no label in the JSON object."
+                      << std::endl;
+            return;
+        }
+        comps.push_back(Component{it->second});
+        leaf_indices.push_back(c);
+    }
+    this->components = comps;
+    this->index_components();
+
+    // Resolve the subassembly of every component in topological order: a union becomes ready once all of its children are resolved
+    std::vector<SubassemblyMask> comp_masks(comp_ids.size(), SubassemblyMask(this->components.size()));
+    std::vector<bool> is_resolved(comp_ids.size(), false);
+    std::vector<size_t> missing_children(unions.size());
+    std::vector<size_t> open_comps{};
+    for (size_t i = 0; i < unions.size(); ++i)
+        missing_children.at(i) = union_children.at(i).size();
+    for (size_t leaf : leaf_indices)
+    {
+        comp_masks.at(leaf).set(this->component_ids.at(Component{description.component_labels.at(comp_ids.at(leaf))}));
+        is_resolved.at(leaf) = true;
+        open_comps.push_back(leaf);
     }
-    while(!open_union_ids.empty())
-    {        
-        std::vector<std::string> erasable_union_ids{};
-        std::set<std::string> new_union_ids{};
-        for (const std::string &union_id : open_union_ids)
+    while (!open_comps.empty())
+    {
+        size_t comp{open_comps.back()};
+        open_comps.pop_back();
+
+        for (size_t i : child_unions.at(comp))
         {
-            std::vector<std::string> child_comp_ids = unions.at(union_id).at("child_components");
-            std::sort(component_mapping_ids.begin(), component_mapping_ids.end());
-            std::sort(child_comp_ids.begin(), child_comp_ids.end());
+            if (--missing_children.at(i) > 0 || is_resolved.at(union_parents.at(i)))
+                continue;
 
-            if (std::includes(component_mapping_ids.begin(), component_mapping_ids.end(), child_comp_ids.begin(), child_comp_ids.end()))
-            {
-                std::string parent_comp_id{unions.at(union_id).at("parent_component")};
-                Subassembly child_subasm{};
-                for (const std::string &child_comp_id : child_comp_ids)
-                    child_subasm.insert(child_subasm.end(), comp_subasm_mapping.at(child_comp_id).begin(), comp_subasm_mapping.at(child_comp_id).end() );
-                comp_subasm_mapping.emplace(std::make_pair(parent_comp_id, child_subasm));
-                component_mapping_ids.push_back(parent_comp_id);
-
-                erasable_union_ids.push_back(union_id);
-                std::vector<std::string> new_parent_unions = components.at(parent_comp_id).at("parent_unions");
-                std::copy(new_parent_unions.begin(), new_parent_unions.end(), std::inserter(new_union_ids, new_union_ids.end()));
-            }
+            size_t parent{union_parents.at(i)};
+            for (size_t child : union_children.at(i))
+                comp_masks.at(parent) |= comp_masks.at(child);
+            is_resolved.at(parent) = true;
+            open_comps.push_back(parent);
         }
-        for (const std::string &u : erasable_union_ids)
-            open_union_ids.erase(std::find(open_union_ids.begin(), open_union_ids.end(), u));
-        open_union_ids.insert(new_union_ids.begin(), new_union_ids.end());
     }
 
-    AndOrGraph<Subassembly> ao_graph{};
-    for (const auto &edge : ao_graph_ids.get_edges())
+    AndOrGraph<Subassembly>::Builder ao_graph{};
+    ao_graph.reserve(comp_ids.size(), unions.size());
+    for (size_t c = 0; c < comp_ids.size(); ++c)
     {
-        int edge_id{std::get<2>(edge)};
-        Subassembly parent_subasm{comp_subasm_mapping.at(std::get<0>(edge))};
-        std::vector<Subassembly> child_subasms{};
-        std::transform(std::get<1>(edge).begin(), std::get<1>(edge).end(), std::back_inserter(child_subasms), 
-            [comp_subasm_mapping](const std::string &child_id)
+        for (size_t i : parent_unions.at(c))
+        {
+            if (!std::all_of(union_children.at(i).begin(), union_children.at(i).end(), [&is_resolved](size_t child) { return is_resolved.at(child); }))
             {
-                return comp_subasm_mapping.at(child_id);
-            });
-        ao_graph.add_edge(parent_subasm, child_subasms, edge_id);
+                std::cerr << "[Import AND-OR graph]: Union " << unions.at(i).union_id << " can't be resolved to leaf components. Skipping it."
+                          << std::endl;
+                continue;
+            }
+
+            std::vector<Subassembly> child_subasms{};
+            for (size_t child : union_children.at(i))
+                child_subasms.push_back(this->to_subassembly(comp_masks.at(child)));
+            ao_graph.add_edge(this->to_subassembly(comp_masks.at(c)), std::move(child_subasms), (has_union_ids && has_unique_union_ids) ? unions.at(i).id : -1);
+        }
     }
-    this->ao_graph = ao_graph;
+    this->ao_graph = ao_graph.build();
+    this->compile_feasibility_rules();
+    this->compute_symmetry_orbits();
+}
 
-    std::vector<Component> comps{};
-    std::transform(leaf_comp_ids.begin(), leaf_comp_ids.end(), std::back_inserter(comps),
-        [components](const std::string &leaf_comp_id){
-            return Component{components.at(leaf_comp_id).at("label")};
-        });
-    this->components = comps;
+void Assembly::import_ao_graph(const nlohmann::json &json)
+{
+    this->build_ao_graph(AoGraphReader::from_json(json));
 }
 
 void Assembly::import_ao_graph(const std::string &file_path)
 {
     std::ifstream file_stream{file_path};
-    nlohmann::json data = nlohmann::json::parse(file_stream);
-    this->import_ao_graph(data);
-}
\ No newline at end of file
+    if (!file_stream.is_open())
+    {
+        std::cerr << "[Import AND-OR graph]: JSON file doesn't exist: " << file_path
+                  << std::endl;
+        return;
+    }
+
+    AoGraphDescription description{};
+    std::string error{};
+    if (!AoGraphReader::read(file_stream, description, error))
+    {
+        std::cerr << "[Import AND-OR graph]: Couldn't parse JSON file " << file_path << ": " << error
+                  << std::endl;
+        return;
+    }
+    this->build_ao_graph(description);
+}
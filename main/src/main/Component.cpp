@@ -5,8 +5,8 @@
 
 #include <main/Component.hpp>
 
-Component::Component(const std::string &name)
-    : name{name}
+Component::Component(const std::string &name, const std::string &equivalence_class)
+    : name{name}, equivalence_class{equivalence_class}
 {
 }
 
@@ -15,6 +15,11 @@ std::string Component::get_name() const
     return this->name;
 }
 
+std::string Component::get_equivalence_class() const
+{
+    return this->equivalence_class;
+}
+
 bool Component::operator==(const Component &rhs) const
 {
     return (this->name == rhs.name);
@@ -0,0 +1,102 @@
+#include <algorithm> // std::any_of, std::find, std::lower_bound, std::sort
+#include <cstddef>   // std::size_t
+#include <utility>   // std::make_pair, std::pair
+#include <vector>    // std::vector
+
+#include <main/RuleIndex.hpp>
+
+RuleIndex::Node::Node()
+    : children{}, component_ids{}
+{
+}
+
+RuleIndex::RuleIndex()
+    : nodes{Node{}}, num_rules{}
+{
+}
+
+RuleIndex::RuleIndex(const std::vector<std::pair<int, SubassemblyMask>> &rules)
+    : RuleIndex()
+{
+    // Inserting the smallest rules first allows every dominated rule to be dropped on insertion.
+    std::vector<std::pair<int, SubassemblyMask>> sorted_rules{rules};
+    std::sort(sorted_rules.begin(), sorted_rules.end(),
+              [](const auto &lhs, const auto &rhs) { return lhs.second.count() < rhs.second.count(); });
+
+    for (const auto &rule : sorted_rules)
+        this->add_rule(rule.first, rule.second);
+}
+
+std::size_t RuleIndex::size() const
+{
+    return this->num_rules;
+}
+
+bool RuleIndex::add_rule(int component_id, const SubassemblyMask &rule)
+{
+    // a rule that contains its own component is satisfied by every subassembly
+    if (component_id >= 0 && static_cast<std::size_t>(component_id) < rule.size() && rule.test(component_id))
+        return false;
+
+    // a rule that is a superset of an indexed rule for the same component can never be violated on its own
+    if (this->is_dominated(rule, component_id, 0))
+        return false;
+
+    int node_id{0};
+    for (std::size_t id{rule.find_first()}; id != SubassemblyMask::npos; id = rule.find_next(id))
+    {
+        std::vector<std::pair<int, int>> &children{this->nodes.at(node_id).children};
+        auto it = std::lower_bound(children.begin(), children.end(), std::make_pair(static_cast<int>(id), 0));
+        if (it != children.end() && it->first == static_cast<int>(id))
+            node_id = it->second;
+        else
+        {
+            int child_id{static_cast<int>(this->nodes.size())};
+            children.insert(it, std::make_pair(static_cast<int>(id), child_id));
+            this->nodes.push_back(Node{});
+            node_id = child_id;
+        }
+    }
+
+    std::vector<int> &guarded_ids{this->nodes.at(node_id).component_ids};
+    guarded_ids.push_back(component_id);
+    ++this->num_rules;
+    return true;
+}
+
+bool RuleIndex::is_dominated(const SubassemblyMask &rule, int component_id, int node_id) const
+{
+    const Node &node{this->nodes.at(node_id)};
+    if (std::find(node.component_ids.begin(), node.component_ids.end(), component_id) != node.component_ids.end())
+        return true;
+
+    for (const auto &child : node.children)
+    {
+        if (rule.test(child.first) && this->is_dominated(rule, component_id, child.second))
+            return true;
+    }
+    return false;
+}
+
+bool RuleIndex::is_violated(const SubassemblyMask &subassembly, int node_id) const
+{
+    const Node &node{this->nodes.at(node_id)};
+    bool violated = std::any_of(node.component_ids.begin(), node.component_ids.end(),
+                                [&subassembly](int component_id) {
+                                    return (component_id < 0 || !subassembly.test(component_id));
+                                });
+    if (violated)
+        return true;
+
+    for (const auto &child : node.children)
+    {
+        if (subassembly.test(child.first) && this->is_violated(subassembly, child.second))
+            return true;
+    }
+    return false;
+}
+
+bool RuleIndex::is_satisfied(const SubassemblyMask &subassembly) const
+{
+    return !this->is_violated(subassembly, 0);
+}
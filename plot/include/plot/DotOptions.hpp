@@ -0,0 +1,19 @@
+#ifndef DOT_OPTIONS_HPP
+#define DOT_OPTIONS_HPP
+
+#include <cstddef> // std::size_t
+#include <vector>  // std::vector
+
+// Level-of-detail limits for the DOT output of large graphs. The defaults write the whole graph.
+struct DotOptions
+{
+    std::size_t max_nodes{0}; // 0 for no limit
+    int max_depth{-1};        // -1 for no limit; edges into deeper nodes are collapsed into one placeholder per node
+    bool with_payloads{true}; // leading comment with the payload of every written node and edge attribute
+
+    // Nodes to write, indexed by node id. Nodes are taken in breadth-first order from the roots and afterwards from
+    // every node that was not reached yet, in id order, so that nodes on cycles or without roots are covered too.
+    std::vector<bool> select_nodes(const std::vector<std::vector<int>> &adjacency_list, const std::vector<int> &root_ids) const;
+};
+
+#endif // DOT_OPTIONS_HPP
@@ -1,16 +1,28 @@
 #ifndef I_PLOTABLE_HPP
 #define I_PLOTABLE_HPP
 
+#include <ostream> // std::ostream
 #include <sstream> // std::stringstream
 #include <string>  // std::string
 
+#include <plot/DotOptions.hpp>
+
 class I_Plotable
 {
 public:
     virtual ~I_Plotable() = default;
 
     virtual std::string get_name() const = 0;
-    virtual std::stringstream generate_dot() const = 0;
+
+    // Writes the DOT representation straight to the stream, without building it in memory first
+    virtual void write_dot(std::ostream &os, const DotOptions &options) const = 0;
+
+    std::stringstream generate_dot(const DotOptions &options = DotOptions{}) const
+    {
+        std::stringstream ss_dot{};
+        this->write_dot(ss_dot, options);
+        return ss_dot;
+    }
 };
 
-#endif // I_PLOTABLE_HPP
\ No newline at end of file
+#endif // I_PLOTABLE_HPP
@@ -0,0 +1,67 @@
+#ifndef PLOT_SERVICE_HPP
+#define PLOT_SERVICE_HPP
+
+#include <condition_variable> // std::condition_variable
+#include <cstddef>            // std::size_t
+#include <deque>              // std::deque
+#include <mutex>              // std::mutex
+#include <string>             // std::string
+#include <thread>             // std::thread
+
+#include <plot/DotOptions.hpp>
+#include <plot/I_Plotable.hpp>
+
+struct GVC_s; // Graphviz context (GVC_t), kept out of this header
+
+enum class PlotFormat
+{
+    png,
+    svg
+};
+
+// Renders plotable objects in the background. The object may not outlive submit(), hence its DOT text is generated
+// into memory on the calling thread; writing the .dot file, parsing the text with agmemread, the layout and the
+// rendering run on a worker thread. The text is bounded by the DotOptions of the job, whose node count is capped by
+// the service, so that large graphs are never held in memory whole. Graphviz is not thread-safe, hence all jobs share
+// one context and are rendered one after the other, in submission order. Without a Graphviz context only the .dot
+// files are written.
+class PlotService
+{
+private:
+    struct Job
+    {
+        std::string dot;
+        std::string file_loc; // output path without extension
+        PlotFormat format;
+    };
+
+    GVC_s *gvc;            // nullptr if Graphviz couldn't be initialized
+    std::size_t max_nodes; // cap on the nodes written per job, 0 for no limit
+    std::deque<Job> jobs;
+    std::size_t num_pending; // queued or being rendered
+    std::mutex jobs_mutex;
+    std::condition_variable jobs_cv;
+    std::condition_variable idle_cv;
+    bool is_stopping;
+    std::thread worker;
+
+    void work();
+    void render(const Job &job) const;
+
+public:
+    static constexpr std::size_t default_max_nodes{10000};
+
+    explicit PlotService(std::size_t max_nodes = default_max_nodes);
+    PlotService(const PlotService &) = delete;
+    PlotService &operator=(const PlotService &) = delete;
+    ~PlotService(); // renders the remaining jobs before returning
+
+    // Queues the object to be plotted to '<output_loc>/<snake case name>.{dot,png,svg}'. Jobs for the same path are
+    // written in submission order.
+    void submit(const I_Plotable &obj, const std::string &output_loc, PlotFormat format = PlotFormat::png, const DotOptions &options = DotOptions{});
+
+    // Blocks until every job submitted so far has been rendered
+    void wait();
+};
+
+#endif // PLOT_SERVICE_HPP
@@ -0,0 +1,59 @@
+#include <algorithm> // std::min
+#include <cstddef>   // std::size_t
+#include <vector>    // std::vector
+
+#include <plot/DotOptions.hpp>
+
+std::vector<bool> DotOptions::select_nodes(const std::vector<std::vector<int>> &adjacency_list, const std::vector<int> &root_ids) const
+{
+    std::size_t num_nodes{adjacency_list.size()};
+    if (this->max_nodes == 0 && this->max_depth < 0)
+        return std::vector<bool>(num_nodes, true);
+
+    // breadth-first order and depth of every node
+    std::vector<int> depths(num_nodes, -1);
+    std::vector<int> order{};
+    order.reserve(num_nodes);
+
+    auto visit = [&adjacency_list, &depths, &order](int start_id) {
+        if (depths.at(start_id) != -1)
+            return;
+
+        depths.at(start_id) = 0;
+        order.push_back(start_id);
+        for (std::size_t i{order.size() - 1}; i < order.size(); ++i)
+        {
+            int node_id{order.at(i)};
+            for (int neighbor_id : adjacency_list.at(node_id))
+            {
+                if (depths.at(neighbor_id) == -1)
+                {
+                    depths.at(neighbor_id) = depths.at(node_id) + 1;
+                    order.push_back(neighbor_id);
+                }
+            }
+        }
+    };
+
+    for (int root_id : root_ids)
+        visit(root_id);
+    for (std::size_t id{0}; id < num_nodes; ++id)
+        visit(id);
+
+    std::size_t budget{this->max_nodes == 0 ? num_nodes : std::min(this->max_nodes, num_nodes)};
+    std::vector<bool> is_selected(num_nodes, false);
+    std::size_t num_selected{0};
+    for (int node_id : order)
+    {
+        if (num_selected == budget)
+            break;
+
+        if (this->max_depth < 0 || depths.at(node_id) <= this->max_depth)
+        {
+            is_selected.at(node_id) = true;
+            ++num_selected;
+        }
+    }
+
+    return is_selected;
+}
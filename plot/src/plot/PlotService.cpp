@@ -0,0 +1,120 @@
+#include <cstddef>  // std::size_t
+#include <fstream>  // std::ofstream
+#include <ios>      // std::ios_base
+#include <iostream> // std::cerr
+#include <mutex>    // std::lock_guard, std::mutex, std::unique_lock
+#include <sstream>  // std::ostringstream
+#include <string>   // std::string
+#include <thread>   // std::thread
+#include <utility>  // std::move
+
+#include <graphviz/gvc.h>
+
+#include <plot/DotOptions.hpp>
+#include <plot/I_Plotable.hpp>
+#include <plot/PlotService.hpp>
+
+#include <utils/utils.hpp>
+
+PlotService::PlotService(std::size_t max_nodes)
+    : gvc{gvContext()}, max_nodes{max_nodes}, jobs{}, num_pending{0}, jobs_mutex{}, jobs_cv{}, idle_cv{}, is_stopping{false}, worker{}
+{
+    if (this->gvc == nullptr)
+        std::cerr << "[PlotService]: Couldn't create Graphviz context, only DOT files are written." << '\n';
+
+    this->worker = std::thread{[this]() { this->work(); }};
+}
+
+PlotService::~PlotService()
+{
+    {
+        std::lock_guard<std::mutex> lock{this->jobs_mutex};
+        this->is_stopping = true;
+    }
+    this->jobs_cv.notify_all();
+    this->worker.join();
+
+    if (this->gvc != nullptr)
+        gvFreeContext(this->gvc);
+}
+
+void PlotService::work()
+{
+    while (true)
+    {
+        Job job{};
+        {
+            std::unique_lock<std::mutex> lock{this->jobs_mutex};
+            this->jobs_cv.wait(lock, [this]() { return this->is_stopping || !this->jobs.empty(); });
+
+            if (this->jobs.empty())
+                return;
+
+            job = std::move(this->jobs.front());
+            this->jobs.pop_front();
+        }
+
+        this->render(job);
+
+        {
+            std::lock_guard<std::mutex> lock{this->jobs_mutex};
+            --this->num_pending;
+        }
+        this->idle_cv.notify_all();
+    }
+}
+
+void PlotService::render(const Job &job) const
+{
+    // only the worker writes files, hence jobs for the same path can't overwrite a file that is still being read
+    std::string dot_path{job.file_loc + ".dot"};
+    std::ofstream dot_file{dot_path, std::ios_base::trunc};
+    if (!dot_file.is_open())
+        std::cerr << "[PlotService]: Couldn't open output file: " << dot_path << '\n';
+    else
+        dot_file << job.dot;
+    dot_file.close();
+
+    if (this->gvc == nullptr)
+        return;
+
+    Agraph_t *graph{agmemread(job.dot.c_str())};
+    if (graph == nullptr)
+    {
+        std::cerr << "[PlotService]: Couldn't parse DOT of: " << dot_path << '\n';
+        return;
+    }
+
+    const char *format{job.format == PlotFormat::svg ? "svg" : "png"};
+    std::string output_path{job.file_loc + "." + format};
+
+    gvLayout(this->gvc, graph, "dot");
+    if (gvRenderFilename(this->gvc, graph, format, output_path.c_str()) != 0)
+        std::cerr << "[PlotService]: Couldn't render output file: " << output_path << '\n';
+
+    gvFreeLayout(this->gvc, graph);
+    agclose(graph);
+}
+
+void PlotService::submit(const I_Plotable &obj, const std::string &output_loc, PlotFormat format, const DotOptions &options)
+{
+    DotOptions job_options{options};
+    if (this->max_nodes != 0 && (job_options.max_nodes == 0 || job_options.max_nodes > this->max_nodes))
+        job_options.max_nodes = this->max_nodes;
+
+    std::ostringstream dot{};
+    obj.write_dot(dot, job_options);
+    Job job{dot.str(), output_loc + "/" + utils::to_snake_case(obj.get_name()), format};
+    {
+        std::lock_guard<std::mutex> lock{this->jobs_mutex};
+        this->jobs.push_back(std::move(job));
+        ++this->num_pending;
+    }
+    this->jobs_cv.notify_one();
+}
+
+void PlotService::wait()
+{
+    std::unique_lock<std::mutex> lock{this->jobs_mutex};
+    this->idle_cv.wait(lock, [this]() { return this->num_pending == 0; });
+}
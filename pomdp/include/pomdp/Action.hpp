@@ -1,18 +1,25 @@
 #ifndef ACTION_HPP
 #define ACTION_HPP
 
-#include <ostream> // std::ostream
-#include <vector>  // std::vector
+#include <cstddef>    // std::size_t
+#include <functional> // std::hash
+#include <ostream>    // std::ostream
+#include <vector>     // std::vector
 
 #include <main/Component.hpp>
 
+#include <pomdp/SubassemblyStore.hpp>
+
 using Subassembly = std::vector<Component>;
 
+// The subassemblies are held as handles of the SubassemblyStore, hence actions compare by handle and the getters
+// resolve the handles.
 class Action
 {
 private:
-    std::vector<Subassembly> preconditions;
-    Subassembly effect;
+    std::vector<SubassemblyStore::Handle> preconditions;
+    SubassemblyStore::Handle effect;
+    std::size_t hash; // of the preconditions and the effect, cached at construction
 
 public:
     Action();
@@ -26,6 +33,20 @@ public:
     bool operator<(const Action &rhs) const;
 
     friend std::ostream &operator<<(std::ostream &os, const Action &action);
+    friend struct std::hash<Action>;
 };
 
-#endif // ACTION_HPP
\ No newline at end of file
+// Custom specialization of std::hash injected in namespace std, so that actions can be used as edge attributes of hashed graphs.
+namespace std
+{
+    template <>
+    struct hash<Action>
+    {
+        std::size_t operator()(Action const &action) const noexcept
+        {
+            return action.hash;
+        }
+    };
+} // namespace std
+
+#endif // ACTION_HPP
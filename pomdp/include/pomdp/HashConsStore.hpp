@@ -0,0 +1,52 @@
+#ifndef HASH_CONS_STORE_HPP
+#define HASH_CONS_STORE_HPP
+
+#include <cstddef>       // std::size_t
+#include <cstdint>       // std::uint32_t
+#include <functional>    // std::hash
+#include <unordered_map> // std::unordered_multimap
+#include <vector>        // std::vector
+
+// Hash-consing store: every distinct value is stored once and referred to by a 32-bit handle, handed out in insertion
+// order. The hash of every value is cached, hence values are hashed once when interned and compared deeply only on
+// hash collisions; two handles of the same store are equal iff their values are.
+template <typename T, typename Hash = std::hash<T>>
+class HashConsStore
+{
+public:
+    using Handle = std::uint32_t;
+
+private:
+    std::vector<T> values;
+    std::vector<std::size_t> hashes;
+    std::unordered_multimap<std::size_t, Handle> handles; // by hash of the value
+    Hash hasher;
+
+    bool find(const T &value, std::size_t hash, Handle &out) const;
+
+public:
+    HashConsStore();
+    ~HashConsStore() = default;
+
+    std::size_t size() const;
+    void reserve(std::size_t num_values);
+
+    // Returns the handle of the stored value, storing it first if it is new. Throws std::length_error if a new value
+    // would need a handle beyond the range of Handle.
+    Handle intern(const T &value);
+    Handle intern(T &&value);
+
+    // As intern(), but returns false if the value was already stored
+    bool insert(T &&value, Handle &out);
+
+    // Returns false if the value is not stored
+    bool find(const T &value, Handle &out) const;
+
+    const T &get(Handle handle) const;
+    std::size_t get_hash(Handle handle) const;
+    const std::vector<T> &get_values() const; // indexed by handle
+};
+
+#include <pomdp/HashConsStore.tpp>
+
+#endif // HASH_CONS_STORE_HPP
@@ -0,0 +1,97 @@
+#include <cstddef>       // std::size_t
+#include <limits>        // std::numeric_limits
+#include <stdexcept>     // std::length_error
+#include <unordered_map> // std::unordered_multimap
+#include <utility>       // std::make_pair, std::move, std::pair
+#include <vector>        // std::vector
+
+template <typename T, typename Hash>
+HashConsStore<T, Hash>::HashConsStore()
+    : values{}, hashes{}, handles{}, hasher{}
+{
+}
+
+template <typename T, typename Hash>
+bool HashConsStore<T, Hash>::find(const T &value, std::size_t hash, Handle &out) const
+{
+    auto range = this->handles.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it)
+    {
+        if (this->values[it->second] == value)
+        {
+            out = it->second;
+            return true;
+        }
+    }
+    return false;
+}
+
+template <typename T, typename Hash>
+std::size_t HashConsStore<T, Hash>::size() const
+{
+    return this->values.size();
+}
+
+template <typename T, typename Hash>
+void HashConsStore<T, Hash>::reserve(std::size_t num_values)
+{
+    this->values.reserve(num_values);
+    this->hashes.reserve(num_values);
+    this->handles.reserve(num_values);
+}
+
+template <typename T, typename Hash>
+typename HashConsStore<T, Hash>::Handle HashConsStore<T, Hash>::intern(const T &value)
+{
+    return this->intern(T{value});
+}
+
+template <typename T, typename Hash>
+typename HashConsStore<T, Hash>::Handle HashConsStore<T, Hash>::intern(T &&value)
+{
+    Handle handle{};
+    this->insert(std::move(value), handle);
+    return handle;
+}
+
+template <typename T, typename Hash>
+bool HashConsStore<T, Hash>::insert(T &&value, Handle &out)
+{
+    std::size_t hash{this->hasher(value)};
+    if (this->find(value, hash, out))
+        return false;
+
+    // a truncated handle would alias a stored value
+    if (this->values.size() > std::numeric_limits<Handle>::max())
+        throw std::length_error{"[HashConsStore]: Number of values exceeds the range of handles."};
+
+    out = static_cast<Handle>(this->values.size());
+    this->values.push_back(std::move(value));
+    this->hashes.push_back(hash);
+    this->handles.emplace(std::make_pair(hash, out));
+    return true;
+}
+
+template <typename T, typename Hash>
+bool HashConsStore<T, Hash>::find(const T &value, Handle &out) const
+{
+    return this->find(value, this->hasher(value), out);
+}
+
+template <typename T, typename Hash>
+const T &HashConsStore<T, Hash>::get(Handle handle) const
+{
+    return this->values.at(handle);
+}
+
+template <typename T, typename Hash>
+std::size_t HashConsStore<T, Hash>::get_hash(Handle handle) const
+{
+    return this->hashes.at(handle);
+}
+
+template <typename T, typename Hash>
+const std::vector<T> &HashConsStore<T, Hash>::get_values() const
+{
+    return this->values;
+}
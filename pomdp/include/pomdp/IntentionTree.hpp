@@ -0,0 +1,33 @@
+#ifndef INTENTION_TREE_HPP
+#define INTENTION_TREE_HPP
+
+#include <cstddef> // std::size_t
+#include <vector>  // std::vector
+
+// Intentions (paths of the reversed state graph) stored as a prefix tree. Every intention is its last state plus the
+// intention it extends, hence extending an intention takes constant memory, intentions sharing a prefix share its
+// storage and two intentions are equal iff their ids are. The state history is only rebuilt on demand.
+class IntentionTree
+{
+private:
+    std::vector<int> state_ids;  // last state of every intention, as a node id of the state graph
+    std::vector<int> parent_ids; // intention extended by every intention, -1 for intentions of a single state
+
+public:
+    IntentionTree();
+    ~IntentionTree() = default;
+
+    std::size_t size() const;
+    void reserve(std::size_t num_intentions);
+
+    // Returns the id of the new intention
+    int add_intention(int state_id, int parent_id = -1);
+
+    int get_state_id(int intention_id) const;
+    int get_parent_id(int intention_id) const;
+
+    // State ids of the intention, in the order they were appended
+    std::vector<int> get_state_ids(int intention_id) const;
+};
+
+#endif // INTENTION_TREE_HPP
@@ -1,16 +1,22 @@
 #ifndef OBSERVATION_HPP
 #define OBSERVATION_HPP
 
-#include <ostream> // std::ostream
-#include <vector>  // std::vector
+#include <cstddef>    // std::size_t
+#include <functional> // std::hash
+#include <ostream>    // std::ostream
+#include <vector>     // std::vector
 
 #include <main/Component.hpp>
 
+#include <pomdp/SubassemblyStore.hpp>
+
+// The manipulated components are held as a handle of the SubassemblyStore, like the subassemblies of actions
 class Observation
 {
 private:
-    std::vector<Component> manip_components;
+    SubassemblyStore::Handle manip_components;
     bool manip_tool;
+    std::size_t hash; // of the manipulated components and the tool flag, cached at construction
 
 public:
     Observation();
@@ -24,6 +30,20 @@ public:
     bool operator<(const Observation &rhs) const;
 
     friend std::ostream &operator<<(std::ostream &os, const Observation &observation);
+    friend struct std::hash<Observation>;
 };
 
-#endif // OBSERVATION_HPP
\ No newline at end of file
+// Custom specialization of std::hash injected in namespace std, so that observations can be interned (see HashConsStore).
+namespace std
+{
+    template <>
+    struct hash<Observation>
+    {
+        std::size_t operator()(Observation const &observation) const noexcept
+        {
+            return observation.hash;
+        }
+    };
+} // namespace std
+
+#endif // OBSERVATION_HPP
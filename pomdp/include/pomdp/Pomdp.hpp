@@ -1,17 +1,23 @@
 #ifndef POMDP_HPP
 #define POMDP_HPP
 
-#include <map>    // std::map
-#include <string> // std::string
-#include <vector> // std::vector
+#include <cstddef>       // std::size_t
+#include <string>        // std::string
+#include <unordered_map> // std::unordered_map
+#include <utility>       // std::pair
+#include <vector>        // std::vector
 
 #include <graph/DiGraph.hpp>
+#include <graph/FrozenDiGraph.hpp>
 
 #include <main/Assembly.hpp>
 #include <main/Component.hpp>
 
 #include <pomdp/Action.hpp>
+#include <pomdp/HashConsStore.hpp>
+#include <pomdp/IntentionTree.hpp>
 #include <pomdp/Observation.hpp>
+#include <pomdp/PomdpSize.hpp>
 
 using Subassembly = std::vector<Component>;
 using State = std::vector<Subassembly>;
@@ -24,12 +30,14 @@ private:
     std::string file_name;
 
     Assembly assembly;
+    size_t num_threads; // number of threads used to generate the state and intention graphs
     DiGraph<State, Action> state_graph;
-    DiGraph<Intention, Action> intention_graph;
+    IntentionTree intention_tree;
+    FrozenDiGraph<int, Action> intention_graph; // nodes are ids of the intention tree, node ids are the POMDP state ids
 
-    std::map<int, Intention> intention_ids;
-    std::map<int, Action> action_ids;
-    std::map<int, Observation> observation_ids;
+    HashConsStore<Action> action_store;           // handles are the action ids
+    HashConsStore<Observation> observation_store; // handles are the observation ids
+    std::vector<int> intention_action_ids;        // action id of every edge attribute of the intention graph
 
     std::unordered_map<int, int> action_obs_mapping;
 
@@ -50,45 +58,51 @@ private:
     std::string policy_file_path;
     std::unordered_map<int, std::vector<std::vector<double>>> policy;
 
-    bool _get_id(const Intention &intention, int &out) const;
     bool _get_id(const Action &action, int &out) const;
     bool _get_id(const Observation &observation, int &out) const;
 
     bool _exist_file(const std::string &file_path) const;
 
-    void _add_intention(const Intention &intention);
     void _add_action(const Action &action);
     void _add_observation(const Observation &observation);
 
+    static Observation _get_observation(const Action &action);
+
     void _init_belief();
     void _init_state_trans();
     void _init_observation_func();
     void _init_reward_func();
 
-    DiGraph<State, Action> _generate_state_graph() const;
-    DiGraph<Intention, Action> _generate_intention_graph() const;
-    std::vector<Intention> _get_state_trans(const Intention &current_intention, const Action &action) const;
-    std::vector<Action> _get_actions(const Intention &intention) const;
-    std::vector<Action> _get_prev_actions(const Intention &intention) const;
-    std::vector<Observation> _get_observations(const Intention &intention) const;
+    static std::vector<std::pair<State, Action>> _expand_state(const Assembly &assembly, const State &state);
+    static DiGraph<State, Action> _generate_state_graph(const Assembly &assembly, size_t num_threads);
+    FrozenDiGraph<int, Action> _generate_intention_graph(IntentionTree &out_intention_tree) const;
+    std::vector<int> _get_state_trans(int current_intention_id, int action_id) const;
+    std::vector<int> _get_action_ids(int intention_id) const;
+    std::vector<int> _get_prev_action_ids(int intention_id) const;
+    std::vector<int> _get_observation_ids(int intention_id) const;
 
 public:
     explicit Pomdp(const std::string &description);
-    explicit Pomdp(const std::string &description, const Assembly &assembly);
+    explicit Pomdp(const std::string &description, const Assembly &assembly, size_t num_threads = 1);
     ~Pomdp() = default;
 
+    // Size of the model Pomdp(description, assembly) would build. Only the state graph is generated, intentions are
+    // counted as its paths without generating them.
+    static PomdpSize estimate_size(const Assembly &assembly, size_t num_threads = 1);
+
     std::string get_description() const;
     std::vector<Intention> get_intentions() const;
-    std::vector<Action> get_actions() const;
-    std::vector<Observation> get_observations() const;
+    Intention get_intention(int intention_id) const; // state history, rebuilt from the intention tree
+    const std::vector<Action> &get_actions() const;           // indexed by action id
+    const std::vector<Observation> &get_observations() const; // indexed by observation id
 
-    DiGraph<State, Action> get_state_graph() const;
-    DiGraph<Intention, Action> get_intention_graph() const;
+    const DiGraph<State, Action> &get_state_graph() const;
+    const FrozenDiGraph<int, Action> &get_intention_graph() const;
 
-    std::vector<double> get_init_belief() const;
-    std::vector<std::vector<std::vector<double>>> get_state_trans_probabilities() const;
-    std::vector<std::vector<std::vector<double>>> get_observation_probabilities() const;
-    std::vector<std::vector<double>> get_rewards() const;
+    const std::vector<double> &get_init_belief() const;
+    const std::vector<std::vector<std::vector<double>>> &get_state_trans_probabilities() const;
+    const std::vector<std::vector<std::vector<double>>> &get_observation_probabilities() const;
+    const std::vector<std::vector<double>> &get_rewards() const;
     double get_discount() const;
 
     int get_num_states() const;
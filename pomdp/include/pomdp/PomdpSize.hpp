@@ -0,0 +1,24 @@
+#ifndef POMDP_SIZE_HPP
+#define POMDP_SIZE_HPP
+
+#include <cstddef> // std::size_t
+
+// Size of the POMDP model of an assembly, counted before building it (see Pomdp::estimate_size()). Intentions are
+// paths of the state graph, hence their number can exceed the range of integers and is kept as a floating-point number.
+struct PomdpSize
+{
+    std::size_t num_states{0};             // nodes of the state graph
+    std::size_t num_state_transitions{0};  // edges of the state graph
+    double num_intentions{0.0};            // POMDP states, i.e. nodes of the intention graph
+    double num_intention_transitions{0.0}; // edges of the intention graph
+    std::size_t num_actions{0};
+    std::size_t num_observations{0};
+
+    // Memory taken by the model parameters, dense as in Pomdp
+    double get_state_trans_bytes() const; // intentions x actions x intentions
+    double get_observation_bytes() const; // intentions x actions x observations
+    double get_reward_bytes() const;      // intentions x actions
+    double get_num_bytes() const;         // all of the above
+};
+
+#endif // POMDP_SIZE_HPP
@@ -10,7 +10,7 @@
 class PomdpxWriter
 {
 private:
-    Pomdp pomdp;
+    const Pomdp &pomdp; // borrowed, has to outlive the writer
 
     tinyxml2::XMLDocument xml_doc;
     tinyxml2::XMLElement *root_ptr;
@@ -0,0 +1,44 @@
+#ifndef SUBASSEMBLY_STORE_HPP
+#define SUBASSEMBLY_STORE_HPP
+
+#include <cstddef>      // std::size_t
+#include <shared_mutex> // std::shared_mutex
+#include <vector>       // std::vector
+
+#include <main/Component.hpp>
+
+#include <pomdp/HashConsStore.hpp>
+
+using Subassembly = std::vector<Component>;
+
+// Process-wide hash-consing store of the subassemblies referred to by actions and observations: every distinct
+// subassembly is stored once, so that actions and observations hold handles and compare them instead of the
+// components. Actions are created by the threads expanding the state graph, hence the store is guarded by a
+// readers-writer lock. Subassemblies are never removed, the store grows with the distinct subassemblies of all models.
+class SubassemblyStore
+{
+public:
+    using Handle = HashConsStore<Subassembly>::Handle;
+
+private:
+    HashConsStore<Subassembly> subassemblies;
+    mutable std::shared_mutex mutex;
+
+    SubassemblyStore();
+
+public:
+    SubassemblyStore(const SubassemblyStore &) = delete;
+    SubassemblyStore &operator=(const SubassemblyStore &) = delete;
+    ~SubassemblyStore() = default;
+
+    static SubassemblyStore &get_instance();
+
+    std::size_t size() const;
+
+    Handle intern(const Subassembly &subassembly);
+
+    Subassembly get(Handle handle) const;      // a copy, since other threads may grow the store meanwhile
+    std::size_t get_hash(Handle handle) const; // std::hash of the subassembly
+};
+
+#endif // SUBASSEMBLY_STORE_HPP
@@ -1,10 +1,14 @@
-#include <algorithm> // std::for_each, std::sort
+#include <algorithm> // std::for_each
+#include <cstddef>   // std::size_t
 #include <ostream>   // std::ostream
 #include <vector>    // std::vector
 
+#include <boost/functional/hash.hpp>
+
 #include <main/Component.hpp>
 
 #include <pomdp/Action.hpp>
+#include <pomdp/SubassemblyStore.hpp>
 
 using Subassembly = std::vector<Component>;
 
@@ -14,28 +18,49 @@ Action::Action()
 }
 
 Action::Action(const std::vector<Subassembly> &preconditions, const Subassembly &effect)
-    : preconditions{preconditions}, effect{effect}
+    : preconditions{}, effect{}, hash{0}
 {
+    SubassemblyStore &store{SubassemblyStore::get_instance()};
+
+    // same value as std::hash of the preconditions and the effect, from the hashes cached by the store
+    std::size_t preconditions_hash{0};
+    this->preconditions.reserve(preconditions.size());
+    for (const Subassembly &precondition : preconditions)
+    {
+        this->preconditions.push_back(store.intern(precondition));
+        boost::hash_combine(preconditions_hash, store.get_hash(this->preconditions.back()));
+    }
+    this->effect = store.intern(effect);
+
+    boost::hash_combine(this->hash, preconditions_hash);
+    boost::hash_combine(this->hash, store.get_hash(this->effect));
 }
 
 std::vector<Subassembly> Action::get_preconditions() const
 {
-    return this->preconditions;
+    SubassemblyStore &store{SubassemblyStore::get_instance()};
+
+    std::vector<Subassembly> preconditions{};
+    preconditions.reserve(this->preconditions.size());
+    for (SubassemblyStore::Handle precondition : this->preconditions)
+        preconditions.push_back(store.get(precondition));
+    return preconditions;
 }
 
 Subassembly Action::get_effect() const
 {
-    return this->effect;
+    return SubassemblyStore::get_instance().get(this->effect);
 }
 
 bool Action::operator==(const Action &rhs) const
 {
+    // handles of the same store are equal iff their subassemblies are
     return ((this->preconditions == rhs.preconditions) && (this->effect == rhs.effect));
 }
 
 bool Action::operator<(const Action &rhs) const
 {
-    return ((this->preconditions < rhs.preconditions) && (this->effect < rhs.effect));
+    return ((this->get_preconditions() < rhs.get_preconditions()) && (this->get_effect() < rhs.get_effect()));
 }
 
 std::ostream &operator<<(std::ostream &os, const Action &action)
@@ -47,4 +72,4 @@ std::ostream &operator<<(std::ostream &os, const Action &action)
                   });
     os << "--> " << action.get_effect();
     return os;
-}
\ No newline at end of file
+}
@@ -0,0 +1,47 @@
+#include <algorithm> // std::reverse
+#include <cstddef>   // std::size_t
+#include <vector>    // std::vector
+
+#include <pomdp/IntentionTree.hpp>
+
+IntentionTree::IntentionTree()
+    : state_ids{}, parent_ids{}
+{
+}
+
+std::size_t IntentionTree::size() const
+{
+    return this->state_ids.size();
+}
+
+void IntentionTree::reserve(std::size_t num_intentions)
+{
+    this->state_ids.reserve(num_intentions);
+    this->parent_ids.reserve(num_intentions);
+}
+
+int IntentionTree::add_intention(int state_id, int parent_id)
+{
+    this->state_ids.push_back(state_id);
+    this->parent_ids.push_back(parent_id);
+    return static_cast<int>(this->state_ids.size() - 1);
+}
+
+int IntentionTree::get_state_id(int intention_id) const
+{
+    return this->state_ids.at(intention_id);
+}
+
+int IntentionTree::get_parent_id(int intention_id) const
+{
+    return this->parent_ids.at(intention_id);
+}
+
+std::vector<int> IntentionTree::get_state_ids(int intention_id) const
+{
+    std::vector<int> state_ids{};
+    for (int id{intention_id}; id != -1; id = this->parent_ids.at(id))
+        state_ids.push_back(this->state_ids.at(id));
+    std::reverse(state_ids.begin(), state_ids.end());
+    return state_ids;
+}
@@ -1,9 +1,12 @@
 #include <ostream> // std::ostream
 #include <vector>  // std::vector
 
+#include <boost/functional/hash.hpp>
+
 #include <main/Component.hpp>
 
 #include <pomdp/Observation.hpp>
+#include <pomdp/SubassemblyStore.hpp>
 
 Observation::Observation()
     : Observation(std::vector<Component>{})
@@ -11,13 +14,15 @@ Observation::Observation()
 }
 
 Observation::Observation(const std::vector<Component> &manip_components, bool manip_tool)
-    : manip_components{manip_components}, manip_tool{manip_tool}
+    : manip_components{SubassemblyStore::get_instance().intern(manip_components)}, manip_tool{manip_tool}, hash{0}
 {
+    boost::hash_combine(this->hash, SubassemblyStore::get_instance().get_hash(this->manip_components));
+    boost::hash_combine(this->hash, this->manip_tool);
 }
 
 std::vector<Component> Observation::get_manip_components() const
 {
-    return this->manip_components;
+    return SubassemblyStore::get_instance().get(this->manip_components);
 }
 
 bool Observation::is_tool_manipulated() const
@@ -32,7 +37,7 @@ bool Observation::operator==(const Observation &rhs) const
 
 bool Observation::operator<(const Observation &rhs) const
 {
-    return ((this->manip_components < rhs.manip_components) && (this->manip_tool < rhs.manip_tool));
+    return ((this->get_manip_components() < rhs.get_manip_components()) && (this->manip_tool < rhs.manip_tool));
 }
 
 std::ostream &operator<<(std::ostream &os, const Observation &observation)
@@ -40,4 +45,4 @@ std::ostream &operator<<(std::ostream &os, const Observation &observation)
     os << observation.get_manip_components() << " - "
        << (observation.is_tool_manipulated() ? "True" : "False");
     return os;
-}
\ No newline at end of file
+}
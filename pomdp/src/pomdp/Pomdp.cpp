@@ -1,9 +1,8 @@
-#include <algorithm>  // std::copy, std::copy_if, std::count_if, std::find, std::for_each, std::max_element, std::sort, std::transform, std::unique
+#include <algorithm>  // std::copy, std::copy_if, std::count_if, std::find, std::for_each, std::max, std::max_element, std::sort, std::transform, std::unique
 #include <cctype>     // std::alpha, std::isdigit, std::isspace
 #include <cstdio>     // std::FILE, std::fclose, std::fopen
 #include <cstdlib>    // std::system
 #include <ctype.h>    // std::tolower
-#include <deque>      // std::deque
 #include <filesystem> // std::filesystem::current_path
 #include <ios>        // std::streamsize
 #include <iostream>   // std::cerr, std::cin, std::cout, std::endl
@@ -12,21 +11,28 @@
 #include <sstream>    // std::istringstream, std::ostringstream
 #include <string>     // std::string
 #include <map>        // std::map
-#include <utility>    // std::make_pair, std::pair
+#include <tuple>      // std::make_tuple, std::tuple
+#include <utility>    // std::make_pair, std::move, std::pair
 #include <vector>     // std::vector
 
 #include <graph/DiGraph.hpp>
+#include <graph/FrozenDiGraph.hpp>
+#include <graph/IdRange.hpp>
+#include <graph/Traversal.hpp>
 
 #include <main/Assembly.hpp>
 #include <main/Component.hpp>
 
 #include <pomdp/Action.hpp>
+#include <pomdp/HashConsStore.hpp>
 #include <pomdp/Observation.hpp>
 #include <pomdp/Pomdp.hpp>
+#include <pomdp/PomdpSize.hpp>
 #include <pomdp/PomdpxWriter.hpp>
 
 #include <tinyxml2.h>
 
+#include <utils/ThreadPool.hpp>
 #include <utils/utils.hpp> // utils::cast_cstring, utils::split_cstring
 
 using Subassembly = std::vector<Component>;
@@ -34,8 +40,8 @@ using State = std::vector<Subassembly>;
 using Intention = std::vector<State>;
 
 Pomdp::Pomdp(const std::string &description)
-    : description{description}, file_name{}, assembly{}, state_graph{}, intention_graph{},
-      intention_ids{}, action_ids{}, observation_ids{}, action_obs_mapping{},
+    : description{description}, file_name{}, assembly{}, num_threads{1}, state_graph{}, intention_tree{}, intention_graph{},
+      action_store{}, observation_store{}, intention_action_ids{}, action_obs_mapping{},
       num_intentions{}, num_actions{}, num_observations{},
       init_belief{}, state_trans_probabilities{}, observation_probabilities{}, rewards{}, discount{},
       robot_actions{}, pomdpx_file_path{}, policy_file_path{}, policy{}
@@ -53,9 +59,9 @@ Pomdp::Pomdp(const std::string &description)
                    });
 }
 
-Pomdp::Pomdp(const std::string &description, const Assembly &assembly)
-    : description{description}, file_name{}, assembly{assembly}, state_graph{}, intention_graph{},
-      intention_ids{}, action_ids{}, observation_ids{}, action_obs_mapping{},
+Pomdp::Pomdp(const std::string &description, const Assembly &assembly, size_t num_threads)
+    : description{description}, file_name{}, assembly{assembly}, num_threads{std::max<size_t>(num_threads, 1)}, state_graph{}, intention_tree{}, intention_graph{},
+      action_store{}, observation_store{}, intention_action_ids{}, action_obs_mapping{},
       num_intentions{}, num_actions{}, num_observations{},
       init_belief{}, state_trans_probabilities{}, observation_probabilities{}, rewards{}, discount{},
       robot_actions{}, pomdpx_file_path{}, policy_file_path{}, policy{}
@@ -73,10 +79,10 @@ Pomdp::Pomdp(const std::string &description, const Assembly &assembly)
                    });
 
     // ACTIONS
-    this->state_graph = this->_generate_state_graph();
+    this->state_graph = Pomdp::_generate_state_graph(this->assembly, this->num_threads);
     this->state_graph.set_name(this->file_name + "_state_graph");
 
-    std::vector<Action> sg_actions{this->state_graph.get_edge_attrs()};
+    const std::vector<Action> &sg_actions{this->state_graph.get_edge_attrs()};
     std::for_each(sg_actions.begin(), sg_actions.end(), [this](const auto &action) {
         this->_add_action(action);
     });
@@ -84,7 +90,7 @@ Pomdp::Pomdp(const std::string &description, const Assembly &assembly)
 
     // robot can only wait or extend existing subassemblies (i.e. grasp one part + tool)
     this->robot_actions.push_back(Action{}); // wait action
-    std::vector<Action> actions{this->get_actions()};
+    const std::vector<Action> &actions{this->get_actions()};
     std::copy_if(actions.begin(), actions.end(), std::back_inserter(this->robot_actions),
                  [](const Action &action) {
                      std::vector<Subassembly> preconditions{action.get_preconditions()};
@@ -95,29 +101,23 @@ Pomdp::Pomdp(const std::string &description, const Assembly &assembly)
                      return (count == 1);
                  });
 
-    this->intention_graph = this->_generate_intention_graph();
-    this->intention_graph.set_name(this->file_name + "_intention_graph");
-
     // INTENTIONS
-    std::vector<Intention> ig_nodes{this->intention_graph.get_nodes()};
-    std::for_each(ig_nodes.begin(), ig_nodes.end(), [this](const auto &node) {
-        this->_add_intention(node);
-    });
+    this->intention_graph = this->_generate_intention_graph(this->intention_tree);
+
+    const std::vector<Action> &ig_actions{this->intention_graph.get_edge_attrs()};
+    std::transform(ig_actions.begin(), ig_actions.end(), std::back_inserter(this->intention_action_ids),
+                   [this](const Action &action) {
+                       int action_id{};
+                       this->_get_id(action, action_id);
+                       return action_id;
+                   });
 
     // OBSERVATIONS
     this->_add_observation(Observation{}); // wait observation
 
     for (const Action &action : this->get_actions())
     {
-        std::vector<Component> manip_components{};
-        for (const Subassembly &subasm : action.get_preconditions())
-        {
-            if (subasm.size() == 1)
-                manip_components.push_back(subasm.front());
-        }
-        std::sort(manip_components.begin(), manip_components.end());
-
-        Observation observation{manip_components, true};
+        Observation observation{Pomdp::_get_observation(action)};
         this->_add_observation(observation);
 
         int action_id{};
@@ -140,7 +140,7 @@ Pomdp::Pomdp(const std::string &description, const Assembly &assembly)
             this->action_obs_mapping.emplace(std::make_pair(action_id, observation_id));
     }
 
-    this->num_intentions = this->get_intentions().size();
+    this->num_intentions = this->intention_graph.get_num_nodes();
     this->num_actions = this->get_actions().size();
     this->num_observations = this->get_observations().size();
 
@@ -151,59 +151,32 @@ Pomdp::Pomdp(const std::string &description, const Assembly &assembly)
     this->discount = 0.9;
 }
 
-bool Pomdp::_get_id(const Intention &intention, int &out) const
-{
-    auto it = std::find_if(this->intention_ids.begin(), this->intention_ids.end(),
-                           [&intention](const auto &m) {
-                               return (m.second == intention);
-                           });
-
-    if (it != intention_ids.end())
-    {
-        out = it->first;
-        return true;
-    }
-    else
-    {
-        out = this->intention_ids.size();
-        return false;
-    }
-}
-
 bool Pomdp::_get_id(const Action &action, int &out) const
 {
-    auto it = std::find_if(this->action_ids.begin(), this->action_ids.end(),
-                           [&action](const auto &m) {
-                               return (m.second == action);
-                           });
-
-    if (it != action_ids.end())
+    HashConsStore<Action>::Handle handle{};
+    if (this->action_store.find(action, handle))
     {
-        out = it->first;
+        out = handle;
         return true;
     }
     else
     {
-        out = this->action_ids.size();
+        out = this->action_store.size();
         return false;
     }
 }
 
 bool Pomdp::_get_id(const Observation &observation, int &out) const
 {
-    auto it = std::find_if(this->observation_ids.begin(), this->observation_ids.end(),
-                           [&observation](const auto &m) {
-                               return (m.second == observation);
-                           });
-
-    if (it != observation_ids.end())
+    HashConsStore<Observation>::Handle handle{};
+    if (this->observation_store.find(observation, handle))
     {
-        out = it->first;
+        out = handle;
         return true;
     }
     else
     {
-        out = this->observation_ids.size();
+        out = this->observation_store.size();
         return false;
     }
 }
@@ -221,43 +194,43 @@ bool Pomdp::_exist_file(const std::string &file_path) const
     }
 }
 
-void Pomdp::_add_intention(const Intention &intention)
+void Pomdp::_add_action(const Action &action)
 {
-    int intention_id{};
-    if (!this->_get_id(intention, intention_id))
-        this->intention_ids.emplace(std::make_pair(intention_id, intention));
+    this->action_store.intern(action);
 }
 
-void Pomdp::_add_action(const Action &action)
+void Pomdp::_add_observation(const Observation &observation)
 {
-    int action_id{};
-    if (!this->_get_id(action, action_id))
-        this->action_ids.emplace(std::make_pair(action_id, action));
+    this->observation_store.intern(observation);
 }
 
-void Pomdp::_add_observation(const Observation &observation)
+Observation Pomdp::_get_observation(const Action &action)
 {
-    int observation_id{};
-    if (!this->_get_id(observation, observation_id))
-        this->observation_ids.emplace(std::make_pair(observation_id, observation));
+    // the human is observed manipulating the single components of the action (and a tool)
+    std::vector<Component> manip_components{};
+    for (const Subassembly &subasm : action.get_preconditions())
+    {
+        if (subasm.size() == 1)
+            manip_components.push_back(subasm.front());
+    }
+    std::sort(manip_components.begin(), manip_components.end());
+
+    return Observation{manip_components, true};
 }
 
 void Pomdp::_init_belief()
 {
     this->init_belief = std::vector<double>(this->num_intentions, 0.0);
-    std::vector<Intention> start_intentions{this->intention_graph.get_root_nodes()};
 
-    for (const Intention &intention : this->get_intentions())
+    std::vector<int> start_intention_ids{};
+    for (int intention_id{0}; intention_id < this->num_intentions; ++intention_id)
     {
-        int intention_id{};
-        if (this->_get_id(intention, intention_id))
-        {
-            if (std::find(start_intentions.begin(), start_intentions.end(), intention) != start_intentions.end())
-                this->init_belief.at(intention_id) = 1.0 / start_intentions.size();
-            else
-                this->init_belief.at(intention_id) = 0.0;
-        }
+        if (this->intention_graph.get_predecessor_ids(intention_id).empty())
+            start_intention_ids.push_back(intention_id);
     }
+
+    for (int start_intention_id : start_intention_ids)
+        this->init_belief.at(start_intention_id) = 1.0 / start_intention_ids.size();
 }
 
 void Pomdp::_init_state_trans()
@@ -267,17 +240,13 @@ void Pomdp::_init_state_trans()
 
     for (int current_intention_id{0}; current_intention_id < this->num_intentions; ++current_intention_id)
     {
-        Intention current_intention{this->intention_ids.at(current_intention_id)};
         for (int action_id{0}; action_id < this->num_actions; ++action_id)
         {
-            Action action{this->action_ids.at(action_id)};
-            std::vector<Intention> next_intentions{this->_get_state_trans(current_intention, action)};
-
-            double uniform_trans_prob{1.0 / next_intentions.size()};
-            std::for_each(next_intentions.begin(), next_intentions.end(),
-                          [this, &current_intention_id, &action_id, &uniform_trans_prob](const Intention next_intention) {
-                              int next_intention_id{};
-                              this->_get_id(next_intention, next_intention_id);
+            std::vector<int> next_intention_ids{this->_get_state_trans(current_intention_id, action_id)};
+
+            double uniform_trans_prob{1.0 / next_intention_ids.size()};
+            std::for_each(next_intention_ids.begin(), next_intention_ids.end(),
+                          [this, &current_intention_id, &action_id, &uniform_trans_prob](int next_intention_id) {
                               this->state_trans_probabilities.at(current_intention_id).at(action_id).at(next_intention_id) = uniform_trans_prob;
                           });
         }
@@ -289,19 +258,19 @@ void Pomdp::_init_observation_func()
     this->observation_probabilities =
         std::vector<std::vector<std::vector<double>>>(this->num_intentions, std::vector<std::vector<double>>(this->num_actions, std::vector<double>(this->num_observations, 0.0)));
 
+    int wait_observation_id{};
+    this->_get_id(Observation{}, wait_observation_id);
+
     for (int intention_id{0}; intention_id < this->num_intentions; ++intention_id)
     {
-        Intention intention{this->intention_ids.at(intention_id)};
         for (int action_id{0}; action_id < this->num_actions; ++action_id)
         {
-            std::vector<Observation> observations{this->_get_observations(intention)};
-
-            double x{1.0 / (observations.size() - 1.0 + 1.0 / 4.0)}; // x * (#observations - 1) + x / 4 = 1;
-            std::for_each(observations.begin(), observations.end(),
-                          [this, &intention_id, &action_id, &x](const Observation observation) {
-                              int observation_id{};
-                              this->_get_id(observation, observation_id);
-                              if (observation == Observation{})
+            std::vector<int> observation_ids{this->_get_observation_ids(intention_id)};
+
+            double x{1.0 / (observation_ids.size() - 1.0 + 1.0 / 4.0)}; // x * (#observations - 1) + x / 4 = 1;
+            std::for_each(observation_ids.begin(), observation_ids.end(),
+                          [this, &intention_id, &action_id, &wait_observation_id, &x](int observation_id) {
+                              if (observation_id == wait_observation_id)
                                   this->observation_probabilities.at(intention_id).at(action_id).at(observation_id) = x / 4.0;
                               else
                                   this->observation_probabilities.at(intention_id).at(action_id).at(observation_id) = x;
@@ -320,21 +289,29 @@ void Pomdp::_init_reward_func()
     int WAIT_REWARD = 0;
     int ACT_NOT_ACC_TASK_ALLOC_REWARD = -2;
 
+    int wait_action_id{};
+    this->_get_id(Action{}, wait_action_id);
+
+    std::vector<bool> is_robot_action(this->num_actions, false);
+    for (const Action &robot_action : this->robot_actions)
+    {
+        int robot_action_id{};
+        if (this->_get_id(robot_action, robot_action_id))
+            is_robot_action.at(robot_action_id) = true;
+    }
+
     for (int intention_id{0}; intention_id < this->num_intentions; ++intention_id)
     {
-        Intention intention{this->intention_ids.at(intention_id)};
+        std::vector<int> possible_action_ids{this->_get_action_ids(intention_id)};
         for (int action_id{0}; action_id < this->num_actions; ++action_id)
         {
-            Action action{this->action_ids.at(action_id)};
-
-            std::vector<Action> possible_actions{this->_get_actions(intention)};
-            if (std::find(possible_actions.begin(), possible_actions.end(), action) != possible_actions.end())
+            if (std::find(possible_action_ids.begin(), possible_action_ids.end(), action_id) != possible_action_ids.end())
             {
-                if (action == Action{})
+                if (action_id == wait_action_id)
                     this->rewards.at(intention_id).at(action_id) = WAIT_REWARD;
                 else
                 {
-                    if (std::find(this->robot_actions.begin(), this->robot_actions.end(), action) != this->robot_actions.end())
+                    if (is_robot_action.at(action_id))
                         this->rewards.at(intention_id).at(action_id) = ACT_ACC_INTENTION_TASK_ALLOC_REWARD;
                     else
                         this->rewards.at(intention_id).at(action_id) = ACT_NOT_ACC_TASK_ALLOC_REWARD;
@@ -346,145 +323,301 @@ void Pomdp::_init_reward_func()
     }
 }
 
-DiGraph<State, Action> Pomdp::_generate_state_graph() const
+std::vector<std::pair<State, Action>> Pomdp::_expand_state(const Assembly &assembly, const State &state)
+{
+    std::vector<std::pair<State, Action>> transitions{};
+    for (const Subassembly &subasm : state)
+    {
+        // with interchangeable components, one representative per symmetric split suffices, since states and
+        // actions are reduced to their canonical forms
+        for (const std::vector<Subassembly> &successor_subasms : assembly.get_successors(subasm, false))
+        {
+            State successor_state{state};
+            successor_state.erase(std::find(successor_state.begin(), successor_state.end(), subasm));
+
+            successor_state.insert(successor_state.end(), successor_subasms.begin(), successor_subasms.end());
+            std::sort(successor_state.begin(), successor_state.end());
+
+            Action action{successor_subasms, subasm};
+            if (assembly.has_symmetries())
+            {
+                successor_state = assembly.get_canonical_partition(successor_state);
+
+                std::vector<Subassembly> preconditions{assembly.get_canonical_partition(successor_subasms)};
+                Subassembly effect{};
+                for (const Subassembly &precondition : preconditions)
+                    effect.insert(effect.end(), precondition.begin(), precondition.end());
+                std::sort(effect.begin(), effect.end());
+                action = Action{preconditions, effect};
+            }
+            transitions.push_back(std::make_pair(std::move(successor_state), std::move(action)));
+        }
+    }
+    return transitions;
+}
+
+DiGraph<State, Action> Pomdp::_generate_state_graph(const Assembly &assembly, size_t num_threads)
 {
-    DiGraph<State, Action> state_graph{};
-    std::deque<State> open_states{};
+    DiGraph<State, Action>::Builder state_graph{};
+    HashConsStore<State> visited_states{}; // states are sorted (and canonical with symmetries), so every state is expanded once
+    std::vector<HashConsStore<State>::Handle> open_states{};
 
-    std::vector<Subassembly> root_subasms{this->assembly.get_ao_graph().get_root_nodes()};
-    std::transform(root_subasms.begin(), root_subasms.end(), std::back_inserter(open_states),
-                   [](const Subassembly &root_subasm) { return State{root_subasm}; });
+    std::vector<Subassembly> root_subasms{assembly.get_ao_graph().get_root_nodes()};
+    for (const Subassembly &root_subasm : root_subasms)
+    {
+        HashConsStore<State>::Handle root_state{};
+        if (visited_states.insert(State{root_subasm}, root_state))
+            open_states.push_back(root_state);
+    }
 
+    // Level-synchronous expansion: the states of a level are expanded in parallel into per-state buffers, which are
+    // merged in frontier order. Hence the graph is the same as the one of a sequential breadth-first search.
+    ThreadPool thread_pool{num_threads};
     while (!open_states.empty())
     {
-        State open_state{open_states.front()};
-        open_states.pop_front();
+        std::vector<std::vector<std::pair<State, Action>>> transitions(open_states.size());
+        thread_pool.parallel_for(open_states.size(), [&assembly, &visited_states, &open_states, &transitions](size_t i) {
+            transitions.at(i) = Pomdp::_expand_state(assembly, visited_states.get(open_states.at(i)));
+        });
 
-        for (const Subassembly &subasm : open_state)
+        std::vector<HashConsStore<State>::Handle> next_open_states{};
+        for (size_t i{0}; i < open_states.size(); ++i)
         {
-            for (const std::vector<Subassembly> &successor_subasms : this->assembly.get_ao_graph().get_successors(subasm))
+            for (std::pair<State, Action> &transition : transitions.at(i))
             {
-                State successor_state{open_state};
-                successor_state.erase(std::find(successor_state.begin(), successor_state.end(), subasm));
-
-                successor_state.insert(successor_state.end(), successor_subasms.begin(), successor_subasms.end());
-                std::sort(successor_state.begin(), successor_state.end());
-
-                Action action{successor_subasms, subasm};
-                state_graph.add_edge(successor_state, open_state, action);
-                open_states.push_back(successor_state);
+                HashConsStore<State>::Handle successor_state{};
+                if (visited_states.insert(std::move(transition.first), successor_state))
+                    next_open_states.push_back(successor_state);
+                state_graph.add_edge(visited_states.get(successor_state), visited_states.get(open_states.at(i)), std::move(transition.second));
             }
         }
+        open_states.swap(next_open_states);
     }
-    return state_graph;
+    return state_graph.build();
 }
 
-DiGraph<Intention, Action> Pomdp::_generate_intention_graph() const
+FrozenDiGraph<int, Action> Pomdp::_generate_intention_graph(IntentionTree &out_intention_tree) const
 {
-    DiGraph<State, Action> state_graph{this->state_graph.reverse()};
+    // intentions are paths of the reversed state graph, starting at the leaf states of the state graph
+    const std::vector<std::pair<int, int>> &state_edge_ids{this->state_graph.get_edge_ids()};
+    const std::vector<int> &state_edge_attr_ids{this->state_graph.get_edge_attr_ids()};
 
-    DiGraph<Intention, Action> intention_graph{};
-    std::deque<Intention> open_intentions{};
+    // (source id, edge attribute id) of the in-edges of every state, in insertion order
+    std::vector<std::vector<std::pair<int, int>>> state_in_edges(this->state_graph.get_nodes().size());
+    for (size_t edge_id{0}; edge_id < state_edge_ids.size(); ++edge_id)
+    {
+        const std::pair<int, int> &edge{state_edge_ids.at(edge_id)};
+        state_in_edges.at(edge.second).push_back(std::make_pair(edge.first, state_edge_attr_ids.at(edge_id)));
+    }
 
-    std::vector<State> root_states{state_graph.get_root_nodes()};
-    std::transform(root_states.begin(), root_states.end(), std::back_inserter(open_intentions),
-                   [](const State &root_state) { return Intention{root_state}; });
+    out_intention_tree = IntentionTree{};
+    std::vector<int> open_intention_ids{}; // ids of the intention tree
 
-    while (!open_intentions.empty())
+    // leaf states in the order of the reversed state graph, which sets the ids of the intentions
+    for (const State &leaf_state : this->state_graph.reverse_view().get_root_nodes())
     {
-        Intention open_intention{open_intentions.front()};
-        open_intentions.pop_front();
+        int state_id{};
+        this->state_graph.get_id(leaf_state, state_id);
+        open_intention_ids.push_back(out_intention_tree.add_intention(state_id));
+    }
 
-        State open_state{open_intention.back()};
-        for (const State &successor_state : state_graph.get_successors(open_state))
+    // The intention graph is collected straight into the arrays of the frozen graph. Its nodes are the intentions
+    // with an edge, numbered by first appearance, and its edge attributes the actions of the state graph, numbered
+    // by first use, as adding the edges one by one to a DiGraph would. Every edge leads from a new intention, hence
+    // there are no duplicate edges.
+    std::vector<int> intention_nodes{};
+    std::vector<int> node_ids{}; // node id of every intention of the tree, -1 if it has no edge yet
+    std::vector<Action> intention_edge_attrs{};
+    std::vector<int> edge_attr_ids(this->state_graph.get_edge_attrs().size(), -1); // by edge attribute id of the state graph
+    std::vector<std::tuple<int, int, int>> intention_edges{};
+
+    auto get_node_id = [&intention_nodes, &node_ids](int intention_id) {
+        if (static_cast<size_t>(intention_id) >= node_ids.size())
+            node_ids.resize(intention_id + 1, -1);
+        if (node_ids.at(intention_id) < 0)
+        {
+            node_ids.at(intention_id) = static_cast<int>(intention_nodes.size());
+            intention_nodes.push_back(intention_id);
+        }
+        return node_ids.at(intention_id);
+    };
+
+    // Level-synchronous like the state graph: the extensions of the intentions of a level are collected in parallel
+    // into per-intention buffers, which are merged in frontier order. Extending an intention only adds one node to
+    // the intention tree.
+    ThreadPool thread_pool{this->num_threads};
+    while (!open_intention_ids.empty())
+    {
+        // predecessor state id and edge attribute id of the state graph of every extension
+        std::vector<std::vector<std::pair<int, int>>> extensions(open_intention_ids.size());
+        thread_pool.parallel_for(open_intention_ids.size(), [&state_in_edges, &out_intention_tree, &open_intention_ids, &extensions](size_t i) {
+            extensions.at(i) = state_in_edges.at(out_intention_tree.get_state_id(open_intention_ids.at(i)));
+        });
+
+        std::vector<int> next_open_intention_ids{};
+        for (size_t i{0}; i < open_intention_ids.size(); ++i)
         {
-            Intention successor_intention{open_intention};
-            successor_intention.push_back(successor_state);
+            for (const std::pair<int, int> &extension : extensions.at(i))
+            {
+                int successor_intention_id{out_intention_tree.add_intention(extension.first, open_intention_ids.at(i))};
+                int successor_id{get_node_id(successor_intention_id)};
+                int open_id{get_node_id(open_intention_ids.at(i))};
+
+                int &edge_attr_id{edge_attr_ids.at(extension.second)};
+                if (edge_attr_id < 0)
+                {
+                    edge_attr_id = static_cast<int>(intention_edge_attrs.size());
+                    intention_edge_attrs.push_back(this->state_graph.get_edge_attrs().at(extension.second));
+                }
 
-            Action action{state_graph.get_edge_attr(std::make_pair(open_state, successor_state))};
-            intention_graph.add_edge(successor_intention, open_intention, action);
-            open_intentions.push_back(successor_intention);
+                intention_edges.push_back(std::make_tuple(successor_id, open_id, edge_attr_id));
+                next_open_intention_ids.push_back(successor_intention_id);
+            }
         }
+        open_intention_ids.swap(next_open_intention_ids);
     }
-    return intention_graph;
+    return FrozenDiGraph<int, Action>{intention_nodes, intention_edge_attrs, intention_edges};
 }
 
-std::vector<Intention> Pomdp::_get_state_trans(const Intention &current_intention, const Action &action) const
+std::vector<int> Pomdp::_get_state_trans(int current_intention_id, int action_id) const
 {
-    std::vector<Intention> next_intentions{};
+    std::vector<int> next_intention_ids{};
 
-    int action_id{};
-    if (this->_get_id(action, action_id))
+    int wait_action_id{};
+    this->_get_id(Action{}, wait_action_id);
+
+    std::vector<int> interm_intention_ids{};
+    if (action_id == wait_action_id) // in case robot performs wait action
+        interm_intention_ids.push_back(current_intention_id);
+    else
     {
-        std::vector<Intention> interm_intentions{};
-        if (action == Action{}) // in case robot performs wait action
-            interm_intentions.push_back(current_intention);
-        else
+        IdRange successor_ids{this->intention_graph.get_successor_ids(current_intention_id)};
+        IdRange successor_action_ids{this->intention_graph.get_successor_attr_ids(current_intention_id)};
+        for (size_t i{0}; i < successor_ids.size(); ++i)
         {
-            std::vector<Intention> successors{this->intention_graph.get_successors(current_intention)};
-            std::copy_if(successors.begin(), successors.end(), std::back_inserter(interm_intentions),
-                         [this, &action, &current_intention](const Intention &successor) {
-                             return (this->intention_graph.get_edge_attr(std::make_pair(current_intention, successor)) == action);
-                         });
+            if (this->intention_action_ids.at(successor_action_ids[i]) == action_id)
+                interm_intention_ids.push_back(successor_ids[i]);
         }
+    }
 
-        for (const Intention interm_intention : interm_intentions)
-        {
-            std::vector<Intention> successors{this->intention_graph.get_successors(interm_intention)};
-            next_intentions.insert(next_intentions.end(), successors.begin(), successors.end());
-            next_intentions.push_back(interm_intention); // in case human decides to wait
-        }
+    for (int interm_intention_id : interm_intention_ids)
+    {
+        for (int successor_id : this->intention_graph.get_successor_ids(interm_intention_id))
+            next_intention_ids.push_back(successor_id);
+        next_intention_ids.push_back(interm_intention_id); // in case human decides to wait
     }
 
     // remove duplicates
-    std::sort(next_intentions.begin(), next_intentions.end());
-    next_intentions.erase(std::unique(next_intentions.begin(), next_intentions.end()), next_intentions.end());
+    std::sort(next_intention_ids.begin(), next_intention_ids.end());
+    next_intention_ids.erase(std::unique(next_intention_ids.begin(), next_intention_ids.end()), next_intention_ids.end());
 
-    if (next_intentions.empty()) // in case no successor states exist
-        next_intentions.push_back(current_intention);
+    if (next_intention_ids.empty()) // in case no successor states exist
+        next_intention_ids.push_back(current_intention_id);
 
-    return next_intentions;
+    return next_intention_ids;
 }
 
-std::vector<Action> Pomdp::_get_actions(const Intention &intention) const
+std::vector<int> Pomdp::_get_action_ids(int intention_id) const
 {
-    std::vector<Action> actions{Action{}}; // wait action is always possible
+    int wait_action_id{};
+    this->_get_id(Action{}, wait_action_id);
+    std::vector<int> action_ids{wait_action_id}; // wait action is always possible
 
-    for (const Intention &successor : this->intention_graph.get_successors(intention))
-    {
-        Action action{this->intention_graph.get_edge_attr(std::make_pair(intention, successor))};
-        actions.push_back(action);
-    }
+    for (int action_id : this->intention_graph.get_successor_attr_ids(intention_id))
+        action_ids.push_back(this->intention_action_ids.at(action_id));
 
-    return actions;
+    return action_ids;
 }
 
-std::vector<Action> Pomdp::_get_prev_actions(const Intention &intention) const
+std::vector<int> Pomdp::_get_prev_action_ids(int intention_id) const
 {
-    std::vector<Action> prev_actions{Action{}}; // wait action is always possible
+    int wait_action_id{};
+    this->_get_id(Action{}, wait_action_id);
+    std::vector<int> prev_action_ids{wait_action_id}; // wait action is always possible
 
-    for (const Intention &predecessor : this->intention_graph.get_predecessors(intention))
-    {
-        Action action{this->intention_graph.get_edge_attr(std::make_pair(predecessor, intention))};
-        prev_actions.push_back(action);
-    }
+    for (int action_id : this->intention_graph.get_predecessor_attr_ids(intention_id))
+        prev_action_ids.push_back(this->intention_action_ids.at(action_id));
 
-    return prev_actions;
+    return prev_action_ids;
 }
 
-std::vector<Observation> Pomdp::_get_observations(const Intention &intention) const
+std::vector<int> Pomdp::_get_observation_ids(int intention_id) const
 {
-    std::vector<Observation> observations{};
+    std::vector<int> observation_ids{};
+
+    for (int prev_action_id : this->_get_prev_action_ids(intention_id))
+        observation_ids.push_back(this->action_obs_mapping.at(prev_action_id));
 
-    for (const Action &prev_action : this->_get_prev_actions(intention))
+    return observation_ids;
+}
+
+PomdpSize Pomdp::estimate_size(const Assembly &assembly, size_t num_threads)
+{
+    PomdpSize size{};
+    num_threads = std::max<size_t>(num_threads, 1);
+
+    // Only the edges are needed to count the intentions, hence the state graph is kept as an id graph while counting.
+    // The full state graph exists until then, as in the first phase of the model construction.
+    FrozenDiGraph<int> state_graph{};
+    {
+        DiGraph<State, Action> full_state_graph{Pomdp::_generate_state_graph(assembly, num_threads)};
+        size.num_states = full_state_graph.get_nodes().size();
+        size.num_state_transitions = full_state_graph.get_edge_ids().size();
+
+        // actions and observations as in the constructor
+        HashConsStore<Action> actions{};
+        for (const Action &action : full_state_graph.get_edge_attrs())
+            actions.intern(action);
+        actions.intern(Action{}); // wait action
+
+        HashConsStore<Observation> observations{};
+        observations.intern(Observation{}); // wait observation
+        for (const Action &action : actions.get_values())
+            observations.intern(Pomdp::_get_observation(action));
+
+        size.num_actions = actions.size();
+        size.num_observations = observations.size();
+
+        std::vector<int> state_ids(size.num_states);
+        for (size_t state_id{0}; state_id < size.num_states; ++state_id)
+            state_ids.at(state_id) = static_cast<int>(state_id);
+
+        std::vector<std::tuple<int, int, int>> state_edges{};
+        state_edges.reserve(size.num_state_transitions);
+        for (const std::pair<int, int> &edge : full_state_graph.get_edge_ids())
+            state_edges.push_back(std::make_tuple(edge.first, edge.second, 0));
+        state_graph = FrozenDiGraph<int>{state_ids, std::vector<int>{0}, state_edges};
+    }
+
+    // The intentions ending at a state are the paths from the state to any leaf state, hence their number follows
+    // from the successors, which are counted first. Every intention ending at a state is extended by every edge into
+    // the state.
+    ThreadPool thread_pool{num_threads};
+    std::vector<int> sorted_state_ids{};
+    if (!traversal::topological_sort(state_graph, thread_pool, sorted_state_ids))
     {
-        int prev_action_id{};
-        this->_get_id(prev_action, prev_action_id);
-        int observation_id{this->action_obs_mapping.at(prev_action_id)};
-        observations.push_back(this->observation_ids.at(observation_id));
+        std::cerr << "[Pomdp]: State graph is not acyclic, the number of intentions is unbounded." << std::endl;
+        size.num_intentions = std::numeric_limits<double>::infinity();
+        size.num_intention_transitions = std::numeric_limits<double>::infinity();
+        return size;
     }
 
-    return observations;
+    std::vector<double> num_paths(size.num_states, 0.0);
+    for (auto it = sorted_state_ids.rbegin(); it != sorted_state_ids.rend(); ++it)
+    {
+        IdRange successor_ids{state_graph.get_successor_ids(*it)};
+        if (successor_ids.empty())
+            num_paths.at(*it) = 1.0;
+        for (int successor_id : successor_ids)
+            num_paths.at(*it) += num_paths.at(successor_id);
+
+        std::size_t num_predecessors{state_graph.get_predecessor_ids(*it).size()};
+        if (num_predecessors > 0 || !successor_ids.empty()) // the intention graph only holds intentions with an edge
+            size.num_intentions += num_paths.at(*it);
+        size.num_intention_transitions += num_predecessors * num_paths.at(*it);
+    }
+
+    return size;
 }
 
 std::string Pomdp::get_description() const
@@ -495,53 +628,58 @@ std::string Pomdp::get_description() const
 std::vector<Intention> Pomdp::get_intentions() const
 {
     std::vector<Intention> intentions{};
-    std::transform(this->intention_ids.begin(), this->intention_ids.end(), std::back_inserter(intentions),
-                   [](const auto &intention_id) { return intention_id.second; });
+    intentions.reserve(this->intention_graph.get_num_nodes());
+    for (size_t intention_id{0}; intention_id < this->intention_graph.get_num_nodes(); ++intention_id)
+        intentions.push_back(this->get_intention(intention_id));
     return intentions;
 }
 
-std::vector<Action> Pomdp::get_actions() const
+Intention Pomdp::get_intention(int intention_id) const
+{
+    const std::vector<State> &states{this->state_graph.get_nodes()};
+
+    Intention intention{};
+    for (int state_id : this->intention_tree.get_state_ids(this->intention_graph.get_node(intention_id)))
+        intention.push_back(states.at(state_id));
+    return intention;
+}
+
+const std::vector<Action> &Pomdp::get_actions() const
 {
-    std::vector<Action> actions{};
-    std::transform(this->action_ids.begin(), this->action_ids.end(), std::back_inserter(actions),
-                   [](const auto &action_id) { return action_id.second; });
-    return actions;
+    return this->action_store.get_values();
 }
 
-std::vector<Observation> Pomdp::get_observations() const
+const std::vector<Observation> &Pomdp::get_observations() const
 {
-    std::vector<Observation> observations{};
-    std::transform(this->observation_ids.begin(), this->observation_ids.end(), std::back_inserter(observations),
-                   [](const auto &observation_id) { return observation_id.second; });
-    return observations;
+    return this->observation_store.get_values();
 }
 
-DiGraph<State, Action> Pomdp::get_state_graph() const
+const DiGraph<State, Action> &Pomdp::get_state_graph() const
 {
     return this->state_graph;
 }
 
-DiGraph<Intention, Action> Pomdp::get_intention_graph() const
+const FrozenDiGraph<int, Action> &Pomdp::get_intention_graph() const
 {
     return this->intention_graph;
 }
 
-std::vector<double> Pomdp::get_init_belief() const
+const std::vector<double> &Pomdp::get_init_belief() const
 {
     return this->init_belief;
 }
 
-std::vector<std::vector<std::vector<double>>> Pomdp::get_state_trans_probabilities() const
+const std::vector<std::vector<std::vector<double>>> &Pomdp::get_state_trans_probabilities() const
 {
     return this->state_trans_probabilities;
 }
 
-std::vector<std::vector<std::vector<double>>> Pomdp::get_observation_probabilities() const
+const std::vector<std::vector<std::vector<double>>> &Pomdp::get_observation_probabilities() const
 {
     return this->observation_probabilities;
 }
 
-std::vector<std::vector<double>> Pomdp::get_rewards() const
+const std::vector<std::vector<double>> &Pomdp::get_rewards() const
 {
     return this->rewards;
 }
@@ -720,7 +858,7 @@ Action Pomdp::get_optimal_action(const std::vector<double> &belief) const
                                    [](const std::pair<int, double> &p1, const std::pair<int, double> &p2) {
                                        return p1.second < p2.second;
                                    });
-        optimal_action = this->action_ids.at(it->first);
+        optimal_action = this->action_store.get(it->first);
     }
     else
         std::cerr << "[Action selection]: No policy available!"
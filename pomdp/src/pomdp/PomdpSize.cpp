@@ -0,0 +1,28 @@
+#include <vector> // std::vector
+
+#include <pomdp/PomdpSize.hpp>
+
+double PomdpSize::get_state_trans_bytes() const
+{
+    return this->num_intentions * sizeof(std::vector<std::vector<double>>) +
+           this->num_intentions * this->num_actions * sizeof(std::vector<double>) +
+           this->num_intentions * this->num_actions * this->num_intentions * sizeof(double);
+}
+
+double PomdpSize::get_observation_bytes() const
+{
+    return this->num_intentions * sizeof(std::vector<std::vector<double>>) +
+           this->num_intentions * this->num_actions * sizeof(std::vector<double>) +
+           this->num_intentions * this->num_actions * this->num_observations * sizeof(double);
+}
+
+double PomdpSize::get_reward_bytes() const
+{
+    return this->num_intentions * sizeof(std::vector<double>) +
+           this->num_intentions * this->num_actions * sizeof(double);
+}
+
+double PomdpSize::get_num_bytes() const
+{
+    return this->get_state_trans_bytes() + this->get_observation_bytes() + this->get_reward_bytes();
+}
@@ -171,7 +171,7 @@ void PomdpxWriter::_gen_state_trans_func()
     param_ptr->SetAttribute("type", "TBL");
     cond_prob_ptr->InsertEndChild(param_ptr);
 
-    std::vector<std::vector<std::vector<double>>> state_trans_prob{this->pomdp.get_state_trans_probabilities()};
+    const std::vector<std::vector<std::vector<double>>> &state_trans_prob{this->pomdp.get_state_trans_probabilities()};
     for (int curr_state_id{0}; curr_state_id < this->pomdp.get_num_states(); ++curr_state_id)
     {
         for (int action_id{0}; action_id < this->pomdp.get_num_actions(); ++action_id)
@@ -233,7 +233,7 @@ void PomdpxWriter::_gen_obs_func()
     param_ptr->SetAttribute("type", "TBL");
     cond_prob_ptr->InsertEndChild(param_ptr);
 
-    std::vector<std::vector<std::vector<double>>> obs_prob{this->pomdp.get_observation_probabilities()};
+    const std::vector<std::vector<std::vector<double>>> &obs_prob{this->pomdp.get_observation_probabilities()};
     for (int state_id{0}; state_id < this->pomdp.get_num_states(); ++state_id)
     {
         for (int action_id{0}; action_id < this->pomdp.get_num_actions(); ++action_id)
@@ -295,7 +295,7 @@ void PomdpxWriter::_gen_reward_func()
     param_ptr->SetAttribute("type", "TBL");
     func_ptr->InsertEndChild(param_ptr);
 
-    std::vector<std::vector<double>> rewards{this->pomdp.get_rewards()};
+    const std::vector<std::vector<double>> &rewards{this->pomdp.get_rewards()};
     for (int state_id{0}; state_id < this->pomdp.get_num_states(); ++state_id)
     {
         for (int action_id{0}; action_id < this->pomdp.get_num_actions(); ++action_id)
@@ -0,0 +1,51 @@
+#include <cstddef>      // std::size_t
+#include <mutex>        // std::unique_lock
+#include <shared_mutex> // std::shared_lock, std::shared_mutex
+
+#include <main/Component.hpp>
+
+#include <pomdp/HashConsStore.hpp>
+#include <pomdp/SubassemblyStore.hpp>
+
+SubassemblyStore::SubassemblyStore()
+    : subassemblies{}, mutex{}
+{
+}
+
+SubassemblyStore &SubassemblyStore::get_instance()
+{
+    static SubassemblyStore instance{};
+    return instance;
+}
+
+std::size_t SubassemblyStore::size() const
+{
+    std::shared_lock<std::shared_mutex> lock{this->mutex};
+    return this->subassemblies.size();
+}
+
+SubassemblyStore::Handle SubassemblyStore::intern(const Subassembly &subassembly)
+{
+    // most subassemblies are already stored, which only needs the shared lock
+    Handle handle{};
+    {
+        std::shared_lock<std::shared_mutex> lock{this->mutex};
+        if (this->subassemblies.find(subassembly, handle))
+            return handle;
+    }
+
+    std::unique_lock<std::shared_mutex> lock{this->mutex};
+    return this->subassemblies.intern(subassembly);
+}
+
+Subassembly SubassemblyStore::get(Handle handle) const
+{
+    std::shared_lock<std::shared_mutex> lock{this->mutex};
+    return this->subassemblies.get(handle);
+}
+
+std::size_t SubassemblyStore::get_hash(Handle handle) const
+{
+    std::shared_lock<std::shared_mutex> lock{this->mutex};
+    return this->subassemblies.get_hash(handle);
+}
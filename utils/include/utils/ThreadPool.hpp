@@ -0,0 +1,43 @@
+#ifndef THREAD_POOL_HPP
+#define THREAD_POOL_HPP
+
+#include <condition_variable> // std::condition_variable
+#include <cstddef>            // std::size_t
+#include <deque>              // std::deque
+#include <functional>         // std::function
+#include <mutex>              // std::mutex
+#include <thread>             // std::thread
+#include <vector>             // std::vector
+
+// Fixed-size pool of worker threads. The thread calling parallel_for() takes part in the work, hence a pool
+// of 'num_threads' threads only spawns 'num_threads - 1' workers and a pool of one thread runs everything inline.
+class ThreadPool
+{
+private:
+    std::vector<std::thread> workers;
+    std::deque<std::function<void()>> tasks;
+    std::mutex tasks_mutex;
+    std::condition_variable tasks_cv;
+    bool is_stopping;
+
+    void work();
+
+public:
+    explicit ThreadPool(std::size_t num_threads = 1);
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+    ~ThreadPool();
+
+    std::size_t get_num_threads() const;
+
+    void submit(const std::function<void()> &task);
+
+    // Calls func(i) for every i in [0, num_items) and blocks until all calls have returned. Results should be
+    // written to per-item slots, so that merging them afterwards is independent of the thread scheduling.
+    template <typename F>
+    void parallel_for(std::size_t num_items, F &&func);
+};
+
+#include <utils/ThreadPool.tpp>
+
+#endif // THREAD_POOL_HPP
@@ -0,0 +1,78 @@
+#include <algorithm> // std::max, std::min
+#include <atomic>    // std::atomic
+#include <cstddef>   // std::size_t
+#include <exception> // std::current_exception, std::exception_ptr, std::rethrow_exception
+#include <memory>    // std::make_shared, std::shared_ptr
+#include <mutex>     // std::lock_guard, std::mutex, std::unique_lock
+
+template <typename F>
+void ThreadPool::parallel_for(std::size_t num_items, F &&func)
+{
+    std::size_t num_runners{std::min(num_items, this->get_num_threads())};
+    if (num_runners <= 1)
+    {
+        for (std::size_t i{0}; i < num_items; ++i)
+            func(i);
+        return;
+    }
+
+    // Workers that only get scheduled after all items were handed out return without touching 'func',
+    // so the caller never has to wait for queued tasks (which also keeps nested calls from deadlocking).
+    struct SharedState
+    {
+        std::atomic<std::size_t> next_item{0};
+        std::mutex mutex{};
+        std::condition_variable cv{};
+        std::size_t num_running{0};
+        bool is_closed{false};
+        std::exception_ptr error{};
+    };
+    std::shared_ptr<SharedState> state{std::make_shared<SharedState>()};
+    std::size_t grain_size{std::max<std::size_t>(1, num_items / (num_runners * 8))};
+
+    auto run = [state, num_items, grain_size, &func]() {
+        try
+        {
+            for (std::size_t begin{state->next_item.fetch_add(grain_size)}; begin < num_items; begin = state->next_item.fetch_add(grain_size))
+            {
+                std::size_t end{std::min(begin + grain_size, num_items)};
+                for (std::size_t i{begin}; i < end; ++i)
+                    func(i);
+            }
+        }
+        catch (...)
+        {
+            std::lock_guard<std::mutex> lock{state->mutex};
+            if (!state->error)
+                state->error = std::current_exception();
+            state->next_item = num_items;
+        }
+    };
+
+    for (std::size_t runner{1}; runner < num_runners; ++runner)
+    {
+        this->submit([state, run]() {
+            {
+                std::lock_guard<std::mutex> lock{state->mutex};
+                if (state->is_closed)
+                    return;
+                ++state->num_running;
+            }
+            run();
+            {
+                std::lock_guard<std::mutex> lock{state->mutex};
+                --state->num_running;
+            }
+            state->cv.notify_all();
+        });
+    }
+
+    run();
+
+    std::unique_lock<std::mutex> lock{state->mutex};
+    state->is_closed = true;
+    state->cv.wait(lock, [&state]() { return state->num_running == 0; });
+
+    if (state->error)
+        std::rethrow_exception(state->error);
+}
@@ -1,6 +1,9 @@
 #ifndef UTILS_HPP
 #define UTILS_HPP
 
+#include <cstdint> // std::uint64_t
+#include <istream> // std::istream
+#include <ostream> // std::ostream
 #include <string>  // std::string
 #include <utility> // std::pair
 #include <vector>  // std::vector
@@ -31,7 +34,16 @@ namespace utils
     template <typename T>
     T dot_product(const std::vector<T> &v1, const std::vector<T> &v2);
 
+    template <typename T>
+    void write_binary(std::ostream &os, const T &value);
+
+    template <typename T>
+    bool read_binary(std::istream &is, T &value);
+
     std::string to_snake_case(const std::string &string);
+
+    // 64-bit FNV-1a hash; stable across runs and platforms, hence suited for on-disk cache keys
+    std::uint64_t fnv1a_hash(const std::string &data, std::uint64_t seed = 14695981039346656037ULL);
 } // namespace utils
 
 #include <utils/utils.tpp>
@@ -1,10 +1,13 @@
-#include <algorithm> // std::any_of, std::copy, std::transform
-#include <iterator>  // std::back_inserter, std::istream_iterator, std::ostream_iterator
-#include <numeric>   // std::accumulate
-#include <sstream>   // std::istringstream, std::ostringstream, std::stringstream
-#include <string>    // std::getline, std::string
-#include <utility>   // std::make_pair, std::pair
-#include <vector>    // std::vector
+#include <algorithm>   // std::any_of, std::copy, std::transform
+#include <istream>     // std::istream
+#include <iterator>    // std::back_inserter, std::istream_iterator, std::ostream_iterator
+#include <numeric>     // std::accumulate
+#include <ostream>     // std::ostream
+#include <sstream>     // std::istringstream, std::ostringstream, std::stringstream
+#include <string>      // std::getline, std::string
+#include <type_traits> // std::is_trivially_copyable
+#include <utility>     // std::make_pair, std::pair
+#include <vector>      // std::vector
 
 template <typename T>
 std::vector<std::pair<T, T>> utils::cartesian_product(const std::vector<T> &r1, const std::vector<T> &r2)
@@ -115,4 +118,19 @@ T utils::dot_product(const std::vector<T> &v1, const std::vector<T> &v2)
     std::vector<T> v{};
     std::transform(v1.begin(), v1.end(), v2.begin(), std::back_inserter(v), std::multiplies<T>());
     return std::accumulate(v.begin(), v.end(), T{});
-}
\ No newline at end of file
+}
+
+template <typename T>
+void utils::write_binary(std::ostream &os, const T &value)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "write_binary requires a trivially copyable type");
+    os.write(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+template <typename T>
+bool utils::read_binary(std::istream &is, T &value)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "read_binary requires a trivially copyable type");
+    is.read(reinterpret_cast<char *>(&value), sizeof(T));
+    return static_cast<bool>(is);
+}
@@ -0,0 +1,58 @@
+#include <cstddef>    // std::size_t
+#include <functional> // std::function
+#include <mutex>      // std::lock_guard, std::mutex, std::unique_lock
+#include <thread>     // std::thread
+
+#include <utils/ThreadPool.hpp>
+
+ThreadPool::ThreadPool(std::size_t num_threads)
+    : workers{}, tasks{}, tasks_mutex{}, tasks_cv{}, is_stopping{false}
+{
+    for (std::size_t i{1}; i < num_threads; ++i)
+        this->workers.emplace_back([this]() { this->work(); });
+}
+
+ThreadPool::~ThreadPool()
+{
+    {
+        std::lock_guard<std::mutex> lock{this->tasks_mutex};
+        this->is_stopping = true;
+    }
+    this->tasks_cv.notify_all();
+
+    for (std::thread &worker : this->workers)
+        worker.join();
+}
+
+void ThreadPool::work()
+{
+    while (true)
+    {
+        std::function<void()> task{};
+        {
+            std::unique_lock<std::mutex> lock{this->tasks_mutex};
+            this->tasks_cv.wait(lock, [this]() { return this->is_stopping || !this->tasks.empty(); });
+
+            if (this->tasks.empty())
+                return;
+
+            task = std::move(this->tasks.front());
+            this->tasks.pop_front();
+        }
+        task();
+    }
+}
+
+std::size_t ThreadPool::get_num_threads() const
+{
+    return this->workers.size() + 1;
+}
+
+void ThreadPool::submit(const std::function<void()> &task)
+{
+    {
+        std::lock_guard<std::mutex> lock{this->tasks_mutex};
+        this->tasks.push_back(task);
+    }
+    this->tasks_cv.notify_one();
+}
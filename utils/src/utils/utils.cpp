@@ -1,5 +1,6 @@
 #include <algorithm> // std::for_each
 #include <cctype>    // std::isspace
+#include <cstdint>   // std::uint64_t
 #include <string>    // std::string
 
 #include <utils/utils.hpp>
@@ -14,3 +15,14 @@ std::string utils::to_snake_case(const std::string &string)
                   });
     return snake_case_string;
 }
+
+std::uint64_t utils::fnv1a_hash(const std::string &data, std::uint64_t seed)
+{
+    std::uint64_t hash{seed};
+    for (unsigned char c : data)
+    {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}